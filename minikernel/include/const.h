@@ -22,9 +22,12 @@
 #define NULL (void *) 0		/* por si acaso no esta ya definida */
 #endif
 
-#define MAX_PROC 10		/* dimension de tabla de procesos */
+#define MAX_PROC 256		/* dimension por defecto de tabla de procesos */
+#define MAX_PROC_LIMITE 65536	/* dimension maxima (MAX_PROC al arrancar) */
 
 #define TAM_PILA 32768
+#define TAM_PILA_MINIMA 8192	/* limites del tamao de pila que un proceso */
+#define TAM_PILA_MAXIMA 65536	/* puede fijar para los que crea */
 
 
 /*
@@ -35,6 +38,7 @@
 #define LISTO 1
 #define EJECUCION 2
 #define BLOQUEADO 3
+#define ZOMBI 4		/* terminado hasta que su padre lo recoja */
 
 /*
  * Niveles de ejecucin del procesador. 
@@ -64,11 +68,14 @@
 /* frecuencia de reloj requerida (ticks/segundo) */
 #define TICK 100
 
-/* constante usada en implementacion de round robin */
-#define TICKS_POR_RODAJA 10
+/* constantes usadas en implementacion de round robin */
+#define TICKS_POR_RODAJA 10 /* rodaja inicial de cada proceso */
+#define RODAJA_MINIMA 1	/* limites de la rodaja fijada por el proceso */
+#define RODAJA_MAXIMA TICK	/* o ajustada por el modo adaptativo */
 
 /* constantes usada en implementacion de mutex */
-#define NUM_MUT 16 /* numero total de mutex en el sistema */
+#define NUM_MUT 16 /* mutex para los que se dimensiona el indice al arrancar */
+#define MAX_MUT_LIMITE 65536 /* maximo por defecto (o el de la variable MAX_MUTEX) */
 #define NUM_MUT_PROC 4 /* numero maximo de mutex que puede tener
 			  abiertos un proceso */
 #define MAX_NOM_MUT 8 /* longitud maxima de un nombre de mutex */
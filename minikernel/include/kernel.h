@@ -22,6 +22,23 @@
 #include "HAL.h"
 #include "llamsis.h"
 
+/*
+ * Estadisticas del planificador: histograma de la latencia desde que un
+ * proceso pasa a listo hasta que ejecuta, en ms (el intervalo 0 cuenta
+ * las menores de 1 ms, el i las de [2^(i-1), 2^i) y el ultimo las
+ * mayores), histograma de la longitud de la cola de listos y cambios de
+ * contexto voluntarios (al bloquearse) e involuntarios (al ser expulsado)
+ */
+#define NUM_INTERVALOS_LATENCIA 12
+#define NUM_LONG_COLA 16	/* el ultimo cuenta las longitudes mayores */
+
+struct estadisticas_planif {
+	int cambios_voluntarios;
+	int cambios_involuntarios;
+	int latencia[NUM_INTERVALOS_LATENCIA];
+	int long_cola[NUM_LONG_COLA];
+};
+
 /*
  *
  * Definicion del tipo que corresponde con el BCP.
@@ -30,61 +47,315 @@
  */
 typedef struct BCP_t *BCPptr;
 
+/*
+ *
+ * Definicion del tipo que corresponde con la cabecera de una lista
+ * de BCPs. Este tipo se puede usar para diversas listas (procesos listos,
+ * procesos bloqueados en sem�foro, etc.).
+ *
+ */
+
+typedef struct lista_BCPs_t {
+	BCPptr primero;
+	BCPptr ultimo;
+} lista_BCPs;
+
+/*
+ * Tabla de los mutex abiertos por un proceso. Es la propia del BCP hasta
+ * que crea un hilo; desde entonces todos sus hilos comparten una comun
+ * con un contador, como la imagen.
+ */
+typedef struct descriptores_mutex {
+	int descriptores[NUM_MUT_PROC];	/* descriptor de cada mutex abierto o NO_USADO */
+	int num_mutex;	/* numero de mutex abiertos */
+	int lecturas[NUM_MUT_PROC];	/* rdlocks que tienen entre todos sobre cada rwlock */
+	int n_hilos;	/* procesos que la comparten */
+} descriptores_mutex;
+
 typedef struct BCP_t {
 	int id;				/* ident. del proceso */
-	int estado;			/* TERMINADO|LISTO|EJECUCION|BLOQUEADO*/
+	int generacion;		/* veces que se ha reutilizado la entrada */
+	int estado;			/* TERMINADO|LISTO|EJECUCION|BLOQUEADO|ZOMBI*/
+	int estado_fin;		/* valor con el que termino (si es ZOMBI) */
+	BCPptr padre;		/* proceso que lo creo (NULL si ya no existe) */
+	int num_hijos;		/* hijos creados que aun no ha recogido */
+	BCPptr primer_hijo;	/* lista de esos hijos, enlazados por sig_hermano */
+	BCPptr sig_hermano;	/* siguiente hijo del mismo padre */
+	BCPptr *ant_hermano;	/* enlace que apunta a este BCP en la lista de hijos (NULL si no esta) */
+	lista_BCPs hijos_terminados; /* hijos ZOMBI pendientes de recoger */
+	lista_BCPs espera_hijos; /* lista en la que espera a que termine un hijo */
 	contexto_t contexto_regs;	/* copia de regs. de UCP */
 	void * pila;		/* dir. inicial de la pila */
+	int tam_pila;		/* tamao de su pila */
+	int tam_pila_hijos;	/* tamao de pila de los procesos que crea */
 	BCPptr siguiente;	/* puntero a otro BCP */
 	void *info_mem;		/* descriptor del mapa de memoria */
-	int dormir;			/* tiempo que debe dormir */	
+	int *hilos_imagen;	/* contador comun de los hilos o procesos de crear_procesos que comparten info_mem (NULL si no hay) */
+	void *funcion_hilo;	/* funcion y argumento con los que arranca un hilo */
+	void *arg_hilo;
+	int despertar;		/* tick en el que vence su plazo de espera */
+	BCPptr sig_plazo;	/* siguiente BCP en la cubeta de la rueda de plazos */
+	BCPptr *ant_plazo;	/* enlace que apunta a este BCP en la rueda (NULL si no esta) */
+	struct lista_BCPs_t *lista_espera; /* lista en la que esta bloqueado (NULL si ninguna) */
 	int tiempo_sistema;		/* tiempo de ejecucion en modo sistema */
 	int tiempo_usuario;		/* tiempo de ejecucion en modo usuario */
-	int descriptores_mutex[NUM_MUT_PROC];			/* descriptor mutex que tiene asociado el proceso */
-	int num_mutex; /* numero de mutex que tiene el proceso */
+	descriptores_mutex mutex_propios; /* mutex abiertos mientras no comparte la tabla con hilos */
+	descriptores_mutex *mutex_abiertos; /* mutex_propios o la tabla comun con sus hilos */
+	int lecturas_rwlock[NUM_MUT_PROC]; /* rdlocks que tiene el sobre cada rwlock de mutex_abiertos */
 	int vida; /* TICKS que le quedan al proceso */
+	int rodaja; /* TICKS de cada rodaja del proceso */
+	int rodaja_adaptativa; /* 1 si el sistema ajusta la rodaja segun su uso */
+	int rodajas_agotadas; /* veces que ha consumido la rodaja completa */
+	int bloqueos_tempranos; /* veces que se ha bloqueado sin usar media rodaja */
+	int nice; /* CFS: valor nice (-20 el de mas peso, 19 el de menos) */
+	int peso; /* CFS: peso correspondiente al valor nice */
+	long long vruntime; /* CFS: tiempo de ejecucion virtual ponderado */
+	int pos_monticulo; /* CFS y stride: posicion en el monticulo de listos */
+	int tickets; /* stride: parte del procesador que le corresponde */
+	int zancada; /* stride: ZANCADA_BASE/tickets */
+	long long paso; /* stride: avanza zancada por cada tick de ejecucion */
+	int tiempo_real; /* EDF: 1 si es un proceso periodico de tiempo real */
+	int en_edf; /* EDF: 1 si esta en la lista listos_tr */
+	int periodo; /* EDF: periodo en ticks */
+	int presupuesto; /* EDF: ticks de CPU por periodo */
+	int plazo_relativo; /* EDF: plazo desde el inicio de cada periodo */
+	int utilizacion; /* EDF: presupuesto/periodo en milesimas */
+	int proximo_periodo; /* EDF: tick en el que empieza el siguiente periodo */
+	int plazo_absoluto; /* EDF: tick en el que vence el periodo actual */
+	int presupuesto_restante; /* EDF: ticks que le quedan en el periodo actual */
+	int plazos_incumplidos; /* EDF: periodos terminados despues del plazo */
+	int excesos_presupuesto; /* EDF: periodos en los que agoto el presupuesto */
+	unsigned long long ms_listo; /* reloj CMOS cuando paso a listo */
+	int esperando_ejecutar; /* 1 desde que pasa a listo hasta que ejecuta */
+	struct estadisticas_planif estadisticas; /* long_cola: al pasar a listo */
+	int prioridad; /* nivel de prioridad (cola de listos en la que esta) */
+	int prioridad_base; /* la fijada para el proceso, sin la heredada por mutex */
+	struct mutex *mutex_esperado; /* mutex en cuyo lock esta bloqueado o NULL */
 } BCP;
 
+
+
 /*
- *
- * Definicion del tipo que corresponde con la cabecera de una lista
- * de BCPs. Este tipo se puede usar para diversas listas (procesos listos,
- * procesos bloqueados en sem�foro, etc.).
- *
+ * Variable global que identifica el proceso actual
  */
 
-typedef struct{
-	BCP *primero;
-	BCP *ultimo;
-} lista_BCPs;
+BCP * p_proc_actual=NULL;
 
+/*
+ * Identificador del proceso en ejecucion, que lee la biblioteca para
+ * saber si es el propietario de un mutex sin hacer una llamada
+ */
+int id_proc_en_ejecucion = -1;
 
 /*
- * Variable global que identifica el proceso actual
+ * Variable global que representa la tabla de procesos. Se reserva al
+ * arrancar con num_procs_max entradas (MAX_PROC o el valor de la variable
+ * de entorno MAX_PROC) y sus entradas libres forman la lista BCPs_libres.
+ * El identificador de un proceso combina su entrada en la tabla con la
+ * generacion de esta, por lo que no se repite al reutilizar la entrada.
  */
+#define BITS_ENTRADA_PID 16
+#define MASCARA_ENTRADA_PID ((1 << BITS_ENTRADA_PID) - 1)
+#define MAX_GENERACION_PID (1 << (29 - BITS_ENTRADA_PID)) /* id+1 cabe en el cerrojo de un mutex */
 
-BCP * p_proc_actual=NULL;
+BCP *tabla_procs;
+int num_procs_max;
+lista_BCPs BCPs_libres = {NULL, NULL};
+lista_BCPs espera_BCP_libre = {NULL, NULL}; /* esperan para crear un proceso */
+
+/*
+ * Prioridades: cada nivel tiene su propia cola de procesos listos.
+ * El nivel NUM_PRIORIDADES-1 es el mas prioritario.
+ */
+#define NUM_PRIORIDADES 8
+#define PRIORIDAD_POR_DEFECTO 4
+
+/*
+ * Variable global que representa las colas de procesos listos (una por
+ * nivel de prioridad) y el mapa de bits de los niveles que no estan vacios
+ */
+lista_BCPs listas_listos[NUM_PRIORIDADES];
+unsigned int mapa_listos = 0;
+int num_listos = 0; /* procesos en las colas de listos (incluido el actual) */
 
 /*
- * Variable global que representa la tabla de procesos
+ * Politicas de planificacion. Se elige al compilar el sistema
+ * (p.ej. "make PLANIF=PLANIF_MLFQ" en el directorio minikernel)
  */
+#define PLANIF_PRIORIDADES 0	/* prioridades fijas, RR dentro de cada nivel */
+#define PLANIF_MLFQ 1		/* colas multinivel realimentadas */
+#define PLANIF_CFS 2		/* reparto justo por tiempo de ejecucion virtual */
+#define PLANIF_STRIDE 3		/* reparto proporcional a los tickets */
+
+#ifndef POLITICA_PLANIF
+#define POLITICA_PLANIF PLANIF_PRIORIDADES
+#endif
 
-BCP tabla_procs[MAX_PROC];
+int politica_planif = POLITICA_PLANIF;
 
 /*
- * Variable global que representa la cola de procesos listos
+ * MLFQ: cada TICKS_POR_ELEVACION ticks todos los procesos vuelven al
+ * nivel maximo para que ninguno sufra inanicion
  */
-lista_BCPs lista_listos= {NULL, NULL};
+#define TICKS_POR_ELEVACION 100
+int proxima_elevacion = TICKS_POR_ELEVACION; /* tick de la proxima elevacion */
 
 /*
- * Variable global que representa la cola de procesos bloqueados que estan esperando plazos (llamada dormir(int segundos); )
+ * CFS: los procesos listos se guardan en un monticulo ordenado por su
+ * vruntime, que avanza VRUNTIME_POR_TICK*PESO_NICE_0/peso por cada tick de
+ * ejecucion. Se ejecuta siempre el de menor vruntime y la rodaja es la
+ * parte de LATENCIA_CFS que le corresponde por su peso (al menos
+ * GRANULARIDAD_CFS).
  */
-lista_BCPs lista_bloq_dormir= {NULL, NULL};
+#define NICE_MINIMO -20
+#define NICE_MAXIMO 19
+#define PESO_NICE_0 1024
+#define VRUNTIME_POR_TICK 1024	/* avance de vruntime por tick con nice 0 */
+#define LATENCIA_CFS 20		/* en ticks */
+#define GRANULARIDAD_CFS 2	/* en ticks */
+
+/* Peso de cada valor nice (de -20 a 19): cada nivel supone un 10% de CPU */
+const int pesos_nice[NICE_MAXIMO-NICE_MINIMO+1] = {
+	88761, 71755, 56483, 46273, 36291,
+	29154, 23254, 18705, 14949, 11916,
+	9548, 7620, 6100, 4904, 3906,
+	3121, 2501, 1991, 1586, 1277,
+	1024, 820, 655, 526, 423,
+	335, 272, 215, 172, 137,
+	110, 87, 70, 56, 45,
+	36, 29, 23, 18, 15,
+};
+
+BCPptr *monticulo_listos; /* num_procs_max entradas */
+int tam_monticulo = 0;
+int peso_total_listos = 0; /* suma de los pesos de los procesos del monticulo */
+long long min_vruntime = 0; /* vruntime minimo alcanzado (no decrece) */
+
+/*
+ * Stride: el procesador se reparte en proporcion a los tickets de cada
+ * proceso. Se ejecuta el de menor paso durante una rodaja y su paso avanza
+ * su zancada por cada tick, por lo que uno con el doble de tickets avanza
+ * la mitad de deprisa y ejecuta el doble. Usa el mismo monticulo que CFS.
+ */
+#define TICKETS_MAXIMO 1000
+#define TICKETS_POR_DEFECTO 100
+#define ZANCADA_BASE (1 << 20)
+
+long long paso_global = 0; /* paso minimo alcanzado (no decrece) */
+
+/*
+ * Clase de tiempo real EDF (independiente de la politica elegida): un
+ * proceso periodico con presupuesto en su periodo actual esta en la lista
+ * listos_tr, ordenada por plazo absoluto, y se elige antes que cualquier
+ * otro. Si agota el presupuesto compite como un proceso normal hasta su
+ * siguiente periodo. La suma de las utilizaciones (presupuesto/periodo,
+ * en milesimas) no puede superar UTILIZACION_MAXIMA.
+ */
+#define UTILIZACION_MAXIMA 1000
+
+lista_BCPs listos_tr = {NULL, NULL};
+int utilizacion_tr = 0; /* suma de las utilizaciones admitidas */
+
+/*
+ * Rueda jerarquica de plazos para los procesos que estan esperando plazos
+ * (llamadas dormir, dormir_ms y dormir_hasta). Cada proceso se guarda en
+ * la cubeta que corresponde al tick absoluto en el que vence: el nivel 0
+ * tiene una cubeta por tick y cada nivel superior abarca TAM_RUEDA veces
+ * mas ticks por cubeta. Insertar y cancelar un plazo es O(1) y en cada
+ * tick solo se visita una cubeta.
+ */
+#define BITS_RUEDA 6
+#define TAM_RUEDA (1 << BITS_RUEDA)	/* cubetas por nivel */
+#define NIVELES_RUEDA 4
+#define MAX_PLAZO_RUEDA (1 << (BITS_RUEDA*NIVELES_RUEDA)) /* en ticks */
+
+BCPptr rueda_plazos[NIVELES_RUEDA][TAM_RUEDA];
+int tick_rueda = 1; /* siguiente tick que debe tratar la rueda */
+int num_plazos = 0; /* procesos en la rueda */
+
+/*
+ * Reserva de pilas: la pila de un proceso que termina no se libera sino
+ * que se guarda (hasta PILAS_POR_CLASE de cada tamao) para el siguiente
+ * proceso que se cree. Los tamaos son potencias de 2 entre
+ * TAM_PILA_MINIMA y TAM_PILA_MAXIMA.
+ */
+#define NUM_CLASES_PILA 4
+#define PILAS_POR_CLASE 16
+
+// Estructura para devolver el uso de la reserva de pilas
+struct info_pilas {
+    int aciertos; /* pilas obtenidas de la reserva */
+    int fallos; /* pilas creadas por no haber en la reserva */
+    int descartadas; /* pilas liberadas por estar llena la reserva */
+    int en_reserva; /* pilas guardadas actualmente */
+};
+
+void *reserva_pilas[NUM_CLASES_PILA][PILAS_POR_CLASE];
+int num_pilas_reserva[NUM_CLASES_PILA];
+struct info_pilas estadisticas_pilas;
+
+/*
+ * Cache de imagenes: las imagenes cargadas se guardan por nombre de
+ * programa con el numero de procesos que las usan, de modo que crear otro
+ * proceso del mismo programa no vuelve a cargarla. Una imagen sin procesos
+ * sigue en la cache hasta que haga falta su entrada (se expulsa la usada
+ * hace mas tiempo) o dejen de existir procesos. Se desactiva compilando
+ * con "make CACHE_IMAGENES=0".
+ */
+#ifndef MODO_CACHE_IMAGENES
+#define MODO_CACHE_IMAGENES 1
+#endif
+
+#define NUM_IMAGENES_CACHE 8
+#define MAX_NOM_PROG 32
+
+typedef struct {
+	char nombre[MAX_NOM_PROG]; /* programa ("" si la entrada esta libre) */
+	void *imagen; /* descriptor devuelto por crear_imagen */
+	void *pc_inicial;
+	int referencias; /* procesos que la usan */
+	unsigned int ultimo_uso; /* valor de usos_cache en su ultimo uso */
+} imagen_cache;
+
+// Estructura para devolver el uso de la cache de imagenes
+struct info_imagenes {
+    int aciertos; /* imagenes obtenidas de la cache */
+    int fallos; /* imagenes cargadas con crear_imagen */
+    int expulsiones; /* imagenes liberadas para hacer sitio */
+    int ms_carga; /* ms empleados en crear_imagen */
+};
+
+int modo_cache_imagenes = MODO_CACHE_IMAGENES;
+imagen_cache cache_imagenes[NUM_IMAGENES_CACHE];
+unsigned int usos_cache = 0;
+struct info_imagenes estadisticas_imagenes;
+int num_procesos = 0; /* procesos existentes */
+
+/*
+*	Estadisticas del planificador de todo el sistema (long_cola se muestrea
+*	en cada tick)
+*/
+struct estadisticas_planif estadisticas_sistema;
 
 /*
 *	Variable global que representa el numero total de interrupciones de reloj
 */
 int num_int_reloj = 0;
+
+/*
+*	Reloj sin ticks: si no hay procesos listos o solo hay uno, el reloj se
+*	programa para interrumpir en el siguiente plazo (fin de dormir, fin de
+*	rodaja...) y cada interrupcion contabiliza ticks_por_int ticks.
+*	Se desactiva compilando con "make SIN_TICKS=0".
+*/
+#ifndef MODO_SIN_TICKS
+#define MODO_SIN_TICKS 1
+#endif
+
+int modo_sin_ticks = MODO_SIN_TICKS;
+int ticks_por_int = 1; /* ticks que representa cada interrupcion de reloj (divisor de TICK) */
+unsigned long long ms_ultima_int = 0; /* lectura del reloj CMOS en la ultima interrupcion */
+int contabilizando_ticks = 0; /* 1 mientras se tratan los ticks de una interrupcion */
 /*
 *	Variable global que representa si estamos accediendo a una zona de memoria del proceso de usuario
 * 0: representa que no estamos accediendo a una zona de memoria del proceso de usuario
@@ -107,10 +378,41 @@ struct tiempos_ejec {
     int sistema;
 };
 
+// Estructura para devolver los parametros de tiempo real y su cumplimiento
+struct info_tiempo_real {
+    int periodo;
+    int presupuesto;
+    int plazo;
+    int plazos_incumplidos;
+    int excesos_presupuesto;
+};
+
+// Estructura para devolver la rodaja de un proceso y su uso
+struct info_rodaja {
+    int rodaja;
+    int adaptativa;
+    int rodajas_agotadas;
+    int bloqueos_tempranos;
+};
+
 /**
 *	Configuracion del mutex
 */
 int num_mutex_global = 0; /* Numero de mutex creados*/
+int num_mutex_max; /* Maximo de mutex (MAX_MUT_LIMITE o variable MAX_MUTEX) */
+
+/*
+ * Traspaso del mutex: el unlock que encuentra procesos esperando se lo
+ * asigna directamente al primero antes de despertarlo, en vez de dejarlo
+ * libre para que compita con los demas, de modo que los mutex se
+ * conceden en orden FIFO con un unico cambio de contexto por traspaso.
+ * Se desactiva compilando con "make TRASPASO_MUTEX=0".
+ */
+#ifndef MODO_TRASPASO_MUTEX
+#define MODO_TRASPASO_MUTEX 1
+#endif
+
+int modo_traspaso_mutex = MODO_TRASPASO_MUTEX;
 
 // Estados mutex
 #define NO_USADO -1
@@ -121,6 +423,15 @@ int num_mutex_global = 0; /* Numero de mutex creados*/
 #define NO_RECURSIVO 0 
 #define RECURSIVO 1
 
+// Clase de objeto de la tabla de mutex
+#define CLASE_MUTEX 0
+#define CLASE_RWLOCK 1
+#define CLASE_SEMAFORO 2
+
+// Preferencia de un rwlock cuando esperan lectores y escritores
+#define PREFERENCIA_LECTORES 0
+#define PREFERENCIA_ESCRITORES 1
+
 // Tipo de errores
 #define ERROR_GENERICO -1
 #define ERROR_LONGITUD_NOMBRE -10
@@ -128,34 +439,73 @@ int num_mutex_global = 0; /* Numero de mutex creados*/
 #define ERROR_NOMBRE_REPETIDO -12
 #define ERROR_MAX_NUM_MUTEX_PROC -13
 #define ERROR_MUTEX_NO_EXISTE -14
+#define ERROR_PRIORIDAD -15
+#define ERROR_MUTEX_OCUPADO -16	/* trylock sobre mutex de otro proceso o cierre del que usa otro hilo */
+#define ERROR_PLAZO_LOCK -17	/* vence el plazo de lock_timeout */
+#define ERROR_PLAZO_LECTURA -18	/* vence el plazo de leer_caracter_timeout */
+#define ERROR_SIN_CARACTERES -19	/* leer_caracter_no_bloq sin caracteres */
+#define ERROR_RODAJA -20
+#define ERROR_NICE -21
+#define ERROR_PARAMETROS_TR -22
+#define ERROR_ADMISION_TR -23
+#define ERROR_NO_TIEMPO_REAL -24
+#define ERROR_TICKETS -25
+#define ERROR_PROCESO_NO_EXISTE -26
+#define ERROR_TAM_PILA -27
+#define ERROR_NO_HIJO -28
+#define ERROR_PLAZO_CREAR -29
+#define ERROR_TIPO_MUTEX -30	/* operacion sobre un objeto de otra clase */
+#define ERROR_SEM_OCUPADO -31	/* sem_trywait sobre semaforo a 0 */
+
+// Valor de terminacion de un proceso abortado por una excepcion
+#define ESTADO_EXCEPCION -1
 
 // Estructura para guardar los mutex
 typedef struct mutex {
-	char nombre[MAX_NOM_MUT];
-	int tipo;
-	int estado;
+	char nombre[MAX_NOM_MUT+1];
+	int estado; /*NO_USADO o LIBRE si esta creado*/
 	int n_proc_asociados; /*numero de veces que se ha abierto*/
-	int procs_asociados[MAX_PROC]; /*procesos que han creado|abierto este mutex*/
-	// Para lock
-	int id_proceso_lock; /*id del proceso que tiene el mutex*/
-	int n_veces_lock; /*n veces que se ha hecho lock de este mutex*/
+	// Para lock: tipo, cerrojo con el propietario y locks anidados, visibles para la biblioteca
+	palabra_mutex palabra;
 	lista_BCPs procesos_bloqueados; /*lista de procesos bloqueados*/
+	int siguiente; /*siguiente descriptor en su cubeta o en la lista de libres*/
+	int clase; /*CLASE_MUTEX, CLASE_RWLOCK o CLASE_SEMAFORO*/
+	// Para rwlock: el escritor es el propietario de la palabra y espera en procesos_bloqueados
+	int preferencia; /*PREFERENCIA_LECTORES o PREFERENCIA_ESCRITORES*/
+	int n_lectores; /*rdlocks concedidos*/
+	lista_BCPs lectores_bloqueados; /*lista de lectores bloqueados*/
+	// Para semaforo: los que esperan lo hacen en procesos_bloqueados
+	int valor; /*unidades disponibles*/
 } Mutex;
 
-Mutex tabla_mutex[NUM_MUT];
+/*
+ * Tabla de mutex indexada por descriptor. Crece por duplicacion segun se
+ * necesitan entradas, hasta num_mutex_max, y guarda punteros para que
+ * cada mutex conserve su direccion aunque se amplie la tabla (lock
+ * mantiene el puntero mientras el proceso esta bloqueado). Los
+ * descriptores libres se encadenan desde mutex_libres y los usados desde
+ * la cubeta de la tabla hash que corresponde a su nombre.
+ */
+Mutex **tabla_mutex;
+int capacidad_mutex = 0; /* Entradas reservadas en tabla_mutex */
+int mutex_libres; /* Primer descriptor libre o NO_USADO */
+int *cubetas_mutex; /* Primer descriptor de cada cubeta o NO_USADO */
+int num_cubetas_mutex = 0; /* Potencia de 2; se duplica si hay mas mutex */
 
 lista_BCPs lista_bloq_mutex= {NULL, NULL};
 
 // Round Robin
 int id_proc_a_expulsar = NO_USADO;
-void tratamiento_round_robin();
+void tratamiento_round_robin(int ticks);
 
 // Funciones auxiliares
 void esperar_hueco_mutex(char *nombre);
 int cumple_requisitos(char *nombre, int descriptor_mutex);
 int esta_mutex_asociado_a_proc(int des);
+void soltar_lo_propio(unsigned int mutexid, int index_mutex_proc);
 int len(char *string);
 int cmp(char *s1, char *s2);
+unsigned int hash_nombre(char *nombre);
 void cpy(char *dest, char *orig);
 
 // Buffer para guardar los caracteres leidos
@@ -185,6 +535,42 @@ int cerrar_mutex();
 int lock();
 int unlock();
 int leer_caracter();
+int fijar_prioridad();
+int dormir_ms();
+int dormir_hasta();
+int trylock();
+int lock_timeout();
+int leer_caracter_timeout();
+int leer_caracter_no_bloq();
+int fijar_rodaja();
+int info_rodaja();
+int fijar_nice();
+int fijar_tiempo_real();
+int esperar_periodo();
+int info_tiempo_real();
+int fijar_tickets();
+int estadisticas_planif();
+int fijar_tam_pila();
+int info_pilas();
+int info_imagenes();
+int crear_procesos();
+int esperar_proceso();
+int crear_hilo();
+int datos_hilo();
+int ejecutar();
+int crear_proceso_bloq();
+int crear_proceso_timeout();
+int datos_mutex();
+int crear_rwlock();
+int abrir_rwlock();
+int rdlock();
+int wrlock();
+int rwunlock();
+int crear_sem();
+int abrir_sem();
+int sis_sem_wait();
+int sis_sem_post();
+int sis_sem_trywait();
 
 
 /*
@@ -203,13 +589,51 @@ servicio tabla_servicios[NSERVICIOS]={
 	{lock},
 	{unlock},
 	{leer_caracter},
+	{fijar_prioridad},
+	{dormir_ms},
+	{dormir_hasta},
+	{trylock},
+	{lock_timeout},
+	{leer_caracter_timeout},
+	{leer_caracter_no_bloq},
+	{fijar_rodaja},
+	{info_rodaja},
+	{fijar_nice},
+	{fijar_tiempo_real},
+	{esperar_periodo},
+	{info_tiempo_real},
+	{fijar_tickets},
+	{estadisticas_planif},
+	{fijar_tam_pila},
+	{info_pilas},
+	{info_imagenes},
+	{crear_procesos},
+	{esperar_proceso},
+	{crear_hilo},
+	{datos_hilo},
+	{ejecutar},
+	{crear_proceso_bloq},
+	{crear_proceso_timeout},
+	{datos_mutex},
+	{crear_rwlock},
+	{abrir_rwlock},
+	{rdlock},
+	{wrlock},
+	{rwunlock},
+	{crear_sem},
+	{abrir_sem},
+	{sis_sem_wait},
+	{sis_sem_post},
+	{sis_sem_trywait},
 };
 
 /**
 *	Tratamiento de la interrupcion de reloj para la llamada dormir(int segundos);
 */
 void tratamiento_int_dormir();
-void tratamiento_uso_procesador();
+void tratamiento_uso_procesador(int ticks);
+void tratamiento_elevacion_mlfq();
+void tratamiento_tiempo_real(int ticks);
 
 #endif /* _KERNEL_H */
 
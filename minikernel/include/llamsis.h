@@ -19,7 +19,7 @@
 #define _LLAMSIS_H
 
 /* Numero de llamadas disponibles */
-#define NSERVICIOS 12
+#define NSERVICIOS 48
 
 #define CREAR_PROCESO 0
 #define TERMINAR_PROCESO 1
@@ -33,6 +33,64 @@
 #define LOCK 9
 #define UNLOCK 10
 #define LEER_CARACTER 11
+#define FIJAR_PRIORIDAD 12
+#define DORMIR_MS 13
+#define DORMIR_HASTA 14
+#define TRYLOCK 15
+#define LOCK_TIMEOUT 16
+#define LEER_CARACTER_TIMEOUT 17
+#define LEER_CARACTER_NO_BLOQ 18
+#define FIJAR_RODAJA 19
+#define INFO_RODAJA 20
+#define FIJAR_NICE 21
+#define FIJAR_TIEMPO_REAL 22
+#define ESPERAR_PERIODO 23
+#define INFO_TIEMPO_REAL 24
+#define FIJAR_TICKETS 25
+#define ESTADISTICAS_PLANIF 26
+#define FIJAR_TAM_PILA 27
+#define INFO_PILAS 28
+#define INFO_IMAGENES 29
+#define CREAR_PROCESOS 30
+#define ESPERAR_PROCESO 31
+#define CREAR_HILO 32
+#define DATOS_HILO 33
+#define EJECUTAR 34
+#define CREAR_PROCESO_BLOQ 35
+#define CREAR_PROCESO_TIMEOUT 36
+#define DATOS_MUTEX 37
+#define CREAR_RWLOCK 38
+#define ABRIR_RWLOCK 39
+#define RDLOCK 40
+#define WRLOCK 41
+#define RWUNLOCK 42
+#define CREAR_SEM 43
+#define ABRIR_SEM 44
+#define SEM_WAIT 45
+#define SEM_POST 46
+#define SEM_TRYWAIT 47
+
+/*
+ * Palabra de un mutex, compartida entre el nucleo y la biblioteca de
+ * usuario. cerrojo vale CERROJO_LIBRE o identifica al proceso propietario
+ * (CERROJO_DE su id), con el bit CERROJO_CON_ESPERAS si hay procesos
+ * esperando. La biblioteca obtiene y libera el mutex con una sola
+ * operacion atomica sobre cerrojo, por lo que nunca esta ocupado sin
+ * propietario, y solo entra al nucleo si esta ocupado por otro proceso
+ * o, al liberarlo, si hay procesos esperando.
+ */
+#define CERROJO_LIBRE 0
+#define CERROJO_CON_ESPERAS 0x40000000	/* el unlock debe despertar a un proceso */
+#define CERROJO_DE(id) ((id) + 1)	/* los id de proceso son menores que 2^29 */
+#define SIN_PROPIETARIO -1
+#define PROPIETARIO(cerrojo) (((cerrojo) & ~CERROJO_CON_ESPERAS) - 1)
+
+typedef struct palabra_mutex {
+	int cerrojo;	/* CERROJO_LIBRE o el propietario y si hay esperas */
+	int n_veces;	/* locks anidados del propietario */
+	int tipo;	/* NO_RECURSIVO o RECURSIVO */
+	int generacion;	/* cambia en cada cierre del mutex por cualquier proceso */
+} palabra_mutex;
 
 #endif /* _LLAMSIS_H */
 
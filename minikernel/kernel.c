@@ -15,36 +15,7 @@
 
 #include "kernel.h"	/* Contiene defs. usadas por este modulo */
 #include <string.h> /* Need string management*/
-/*
- *
- * Funciones relacionadas con la tabla de procesos:
- *	iniciar_tabla_proc buscar_BCP_libre
- *
- */
-
-/*
- * Funcin que inicia la tabla de procesos
- */
-static void iniciar_tabla_proc(){
-	int i;
-
-	for (i=0; i<MAX_PROC; i++){
-		tabla_procs[i].estado = NO_USADA;
-	}
-}
-
-/*
- * Funcin que busca una entrada libre en la tabla de procesos
- */
-static int buscar_BCP_libre(){
-	int i;
-
-	for (i=0; i<MAX_PROC; i++)
-		if (tabla_procs[i].estado == NO_USADA)
-			return i;
-	return ERROR_GENERICO;
-}
-
+#include <stdlib.h> /* getenv y reserva de las tablas de procesos y mutex */
 /**
 * 	Funcion relacionadas con el buffer de caracteres: 
 * 	iniciar_buffer_caracteres
@@ -60,39 +31,143 @@ static void iniciar_buffer_caracteres(){
 
 /*
 *	Funciones relacionadas con la tabla de mutex:
-*	iniciar_tabla_mutex buscar_mutex_libre buscar_mutex_repetidos
-* NO_USADO
+*	ampliar_tabla_mutex iniciar_tabla_mutex buscar_mutex
+*	insertar_mutex_hash eliminar_mutex_hash buscar_mutex_libre_y_no_repetido
+*	liberar_mutex
 */
-static void iniciar_tabla_mutex(){
-	for (int i=0; i<NUM_MUT; i++){
-		tabla_mutex[i].estado = NO_USADO;
-		cpy(tabla_mutex[i].nombre, "");
-		tabla_mutex[i].n_proc_asociados = 0;
-		tabla_mutex[i].id_proceso_lock = NO_USADO;
-		tabla_mutex[i].n_veces_lock = 0;
-		tabla_mutex[i].procesos_bloqueados.primero = NULL;
+
+/*
+ * Duplica la tabla de mutex (sin pasar de num_mutex_max) y anade las
+ * entradas nuevas a la lista de libres de forma que se usen primero los
+ * descriptores mas bajos. Devuelve -1 si no puede crecer.
+ */
+static int ampliar_tabla_mutex(){
+	int capacidad = capacidad_mutex ? 2*capacidad_mutex : NUM_MUT_PROC;
+	Mutex **tabla;
+
+	if (capacidad > num_mutex_max)
+		capacidad = num_mutex_max;
+	if (capacidad <= capacidad_mutex)
+		return -1;
+	tabla = realloc(tabla_mutex, capacidad*sizeof(Mutex *));
+	if (tabla == NULL)
+		return -1;
+	tabla_mutex = tabla;
+	for (int i=capacidad-1; i>=capacidad_mutex; i--){
+		Mutex *mutex = calloc(1, sizeof(Mutex));
+		if (mutex == NULL)
+			panico("no hay memoria para la tabla de mutex");
+		mutex->estado = NO_USADO;
+		mutex->siguiente = mutex_libres;
+		mutex_libres = i;
+		tabla_mutex[i] = mutex;
 	}
+	printk("-> TABLA DE MUTEX AMPLIADA DE %d A %d ENTRADAS\n", capacidad_mutex, capacidad);
+	capacidad_mutex = capacidad;
+	return 0;
+}
 
+/*
+ * Fija el maximo de mutex del sistema (MAX_MUT_LIMITE salvo que la
+ * variable de entorno MAX_MUTEX indique uno menor) y reserva las primeras
+ * entradas. La tabla y el indice crecen segun se crean mutex.
+ */
+static void iniciar_tabla_mutex(){
+	char *valor = getenv("MAX_MUTEX");
+
+	num_mutex_max = MAX_MUT_LIMITE;
+	if (valor != NULL && atoi(valor) > 0 && atoi(valor) < MAX_MUT_LIMITE)
+		num_mutex_max = atoi(valor);
+	mutex_libres = NO_USADO;
+	num_cubetas_mutex = 1;
+	while (num_cubetas_mutex < NUM_MUT)
+		num_cubetas_mutex *= 2;
+	cubetas_mutex = malloc(num_cubetas_mutex*sizeof(int));
+	if (cubetas_mutex == NULL || ampliar_tabla_mutex() < 0)
+		panico("no hay memoria para la tabla de mutex");
+	for (int i=0; i<num_cubetas_mutex; i++)
+		cubetas_mutex[i] = NO_USADO;
 }
 
-static int buscar_mutex_libre_y_no_repetido(char *nombre){
-	for (int i=0; i<NUM_MUT; i++){
-		if (tabla_mutex[i].estado != NO_USADO && cmp(tabla_mutex[i].nombre, nombre) == 1){
-			return ERROR_NOMBRE_REPETIDO;
-		}
-		if (tabla_mutex[i].estado==NO_USADO)
+static int buscar_mutex(char *nombre){
+	int i = cubetas_mutex[hash_nombre(nombre) & (num_cubetas_mutex-1)];
+
+	while (i != NO_USADO){
+		if (cmp(tabla_mutex[i]->nombre, nombre) == 1)
 			return i;
+		i = tabla_mutex[i]->siguiente;
 	}
-	return ERROR_MAX_NUM_MUTEX;
+	return ERROR_MUTEX_NO_EXISTE;
 }
 
-static int buscar_mutex(char *nombre){
-	for (int i=0; i<NUM_MUT; i++){
-		if (cmp(tabla_mutex[i].nombre, nombre) == 1 ){
-			return i;
+/*
+ * Inserta un descriptor en su cubeta. Si hay mas mutex que cubetas se
+ * duplica la tabla hash y se redistribuyen los mutex existentes.
+ */
+static void insertar_mutex_hash(int des){
+	Mutex *mutex = tabla_mutex[des];
+	int cubeta;
+
+	if (num_mutex_global >= num_cubetas_mutex){
+		int *cubetas = malloc(2*num_cubetas_mutex*sizeof(int));
+		if (cubetas != NULL){
+			free(cubetas_mutex);
+			cubetas_mutex = cubetas;
+			num_cubetas_mutex *= 2;
+			for (int i=0; i<num_cubetas_mutex; i++)
+				cubetas_mutex[i] = NO_USADO;
+			for (int i=0; i<capacidad_mutex; i++){
+				if (i == des || tabla_mutex[i]->estado == NO_USADO)
+					continue;
+				cubeta = hash_nombre(tabla_mutex[i]->nombre) & (num_cubetas_mutex-1);
+				tabla_mutex[i]->siguiente = cubetas_mutex[cubeta];
+				cubetas_mutex[cubeta] = i;
+			}
 		}
 	}
-	return ERROR_MUTEX_NO_EXISTE;
+	cubeta = hash_nombre(mutex->nombre) & (num_cubetas_mutex-1);
+	mutex->siguiente = cubetas_mutex[cubeta];
+	cubetas_mutex[cubeta] = des;
+}
+
+static void eliminar_mutex_hash(int des){
+	int *anterior = &cubetas_mutex[hash_nombre(tabla_mutex[des]->nombre) & (num_cubetas_mutex-1)];
+
+	while (*anterior != des)
+		anterior = &tabla_mutex[*anterior]->siguiente;
+	*anterior = tabla_mutex[des]->siguiente;
+}
+
+/*
+ * Comprueba que el nombre no esta en uso y saca un descriptor de la lista
+ * de libres, ampliando la tabla si esta vacia
+ */
+static int buscar_mutex_libre_y_no_repetido(char *nombre){
+	int des;
+
+	if (buscar_mutex(nombre) >= 0)
+		return ERROR_NOMBRE_REPETIDO;
+	if (mutex_libres == NO_USADO && ampliar_tabla_mutex() < 0)
+		return ERROR_MAX_NUM_MUTEX;
+	des = mutex_libres;
+	mutex_libres = tabla_mutex[des]->siguiente;
+	return des;
+}
+
+/*
+ * Quita de la tabla hash un mutex sin procesos asociados y devuelve su
+ * descriptor a la lista de libres
+ */
+static void liberar_mutex(int des){
+	Mutex *mutex = tabla_mutex[des];
+
+	eliminar_mutex_hash(des);
+	mutex->estado = NO_USADO;
+	cpy(mutex->nombre, "");
+	mutex->clase = CLASE_MUTEX;
+	mutex->n_lectores = 0;
+	mutex->siguiente = mutex_libres;
+	mutex_libres = des;
 }
 
 /*
@@ -100,8 +175,10 @@ static int buscar_mutex(char *nombre){
 *	buscar_descriptor_mutex_proc obtener_mutex_proc
 */
 static int buscar_descriptor_mutex_proc(unsigned int mutexid){
+	if(mutexid >= capacidad_mutex)
+		return ERROR_GENERICO;
 	for(int i = 0; i < NUM_MUT_PROC; i++){
-		if(p_proc_actual->descriptores_mutex[i] == mutexid){
+		if(p_proc_actual->mutex_abiertos->descriptores[i] == mutexid){
 			return i;
 		}
 	}
@@ -110,7 +187,7 @@ static int buscar_descriptor_mutex_proc(unsigned int mutexid){
 
 static int obtener_mutex_proc(){
 	for(int i = 0; i < NUM_MUT_PROC; i++){
-		if(p_proc_actual->descriptores_mutex[i] == NO_USADO){
+		if(p_proc_actual->mutex_abiertos->descriptores[i] == NO_USADO){
 			return i;
 		}
 	}
@@ -120,7 +197,8 @@ static int obtener_mutex_proc(){
 /*
  *
  * Funciones que facilitan el manejo de las listas de BCPs
- *	insertar_ultimo eliminar_primero eliminar_elem
+ *	insertar_ultimo insertar_primero insertar_por_plazo concatenar_lista
+ *	eliminar_primero eliminar_elem
  *
  * NOTA: PRIMERO SE DEBE LLAMAR A eliminar Y LUEGO A insertar
  */
@@ -137,6 +215,49 @@ static void insertar_ultimo(lista_BCPs *lista, BCP * proc){
 	proc->siguiente=NULL;
 }
 
+/*
+ * Inserta un BCP al principio de la lista.
+ */
+static void insertar_primero(lista_BCPs *lista, BCP * proc){
+	if (lista->primero==NULL)
+		lista->ultimo= proc;
+	proc->siguiente=lista->primero;
+	lista->primero= proc;
+}
+
+/*
+ * Inserta un BCP en la lista ordenada por plazo_absoluto, detras de los
+ * que tienen el mismo plazo.
+ */
+static void insertar_por_plazo(lista_BCPs *lista, BCP * proc){
+	BCP *paux=lista->primero;
+
+	if (paux==NULL || proc->plazo_absoluto < paux->plazo_absoluto){
+		insertar_primero(lista, proc);
+		return;
+	}
+	for ( ; paux->siguiente && paux->siguiente->plazo_absoluto <= proc->plazo_absoluto;
+		paux=paux->siguiente);
+	proc->siguiente=paux->siguiente;
+	paux->siguiente=proc;
+	if (lista->ultimo==paux)
+		lista->ultimo=proc;
+}
+
+/*
+ * Pasa todos los BCPs de la lista orig al final de la lista dest.
+ */
+static void concatenar_lista(lista_BCPs *dest, lista_BCPs *orig){
+	if (orig->primero==NULL)
+		return;
+	if (dest->primero==NULL)
+		dest->primero= orig->primero;
+	else
+		dest->ultimo->siguiente=orig->primero;
+	dest->ultimo= orig->ultimo;
+	orig->primero= orig->ultimo= NULL;
+}
+
 /*
  * Elimina el primer BCP de la lista.
  */
@@ -168,796 +289,3074 @@ static void eliminar_elem(lista_BCPs *lista, BCP * proc){
 
 /*
  *
- * Funciones relacionadas con la planificacion
- *	espera_int planificador
+ * Funciones relacionadas con la tabla de procesos:
+ *	iniciar_tabla_proc buscar_BCP_libre liberar_BCP buscar_proceso
+ *
  */
 
 /*
- * Espera a que se produzca una interrupcion
+ * Funcion que reserva e inicia la tabla de procesos. Su dimension es
+ * MAX_PROC salvo que la variable de entorno MAX_PROC indique otra. Todas
+ * las entradas quedan en la lista de libres.
  */
-static void espera_int(){
-	int nivel;
+static void iniciar_tabla_proc(){
+	int i;
+	char *valor = getenv("MAX_PROC");
+
+	num_procs_max = MAX_PROC;
+	if (valor != NULL && atoi(valor) > 0)
+		num_procs_max = (atoi(valor) < MAX_PROC_LIMITE) ? atoi(valor) : MAX_PROC_LIMITE;
+	tabla_procs = calloc(num_procs_max, sizeof(BCP));
+	monticulo_listos = calloc(num_procs_max, sizeof(BCPptr));
+	if (tabla_procs == NULL || monticulo_listos == NULL)
+		panico("no hay memoria para la tabla de procesos");
+	printk("-> TABLA DE PROCESOS DE %d ENTRADAS\n", num_procs_max);
+
+	for (i=0; i<num_procs_max; i++){
+		tabla_procs[i].estado = NO_USADA;
+		insertar_ultimo(&BCPs_libres, &tabla_procs[i]);
+	}
+}
 
-	//printk("-> NO HAY LISTOS. ESPERA INT\n");
+/*
+ * Funcion que obtiene una entrada libre de la tabla de procesos en O(1).
+ * Las entradas se reutilizan en orden FIFO para que tarde en repetirse
+ * la misma.
+ */
+static int buscar_BCP_libre(){
+	BCP *p_proc = BCPs_libres.primero;
 
-	/* Baja al mnimo el nivel de interrupcin mientras espera */
-	nivel=fijar_nivel_int(NIVEL_1);
-	halt();
-	fijar_nivel_int(nivel);
+	if (p_proc == NULL)
+		return ERROR_GENERICO;
+	eliminar_primero(&BCPs_libres);
+	return p_proc - tabla_procs;
 }
 
 /*
- * Funcin de planificacion que implementa un algoritmo Round-Robin.
+ * Funcion que devuelve una entrada a la lista de libres pasando a la
+ * siguiente generacion para que su proximo identificador sea distinto
  */
-static BCP * planificador(){
-	while (lista_listos.primero == NULL)
-		espera_int();		/* No hay nada que hacer */
-	
-	BCPptr p_proc = lista_listos.primero;
-	// Cualquier proceso que entre a ejecutar, debera tener la rodaja completa
-	p_proc->vida = TICKS_POR_RODAJA;
+static void liberar_BCP(BCP *p_proc){
+	p_proc->estado = NO_USADA;
+	p_proc->generacion = (p_proc->generacion + 1) % MAX_GENERACION_PID;
+	insertar_ultimo(&BCPs_libres, p_proc);
+}
 
-	return p_proc;
+/*
+ * Funcion que devuelve el BCP del proceso con el identificador indicado
+ * o NULL si no existe (o es de una generacion anterior de su entrada)
+ */
+static BCP * buscar_proceso(int id){
+	int entrada = id & MASCARA_ENTRADA_PID;
+
+	if (id < 0 || entrada >= num_procs_max)
+		return NULL;
+	if (tabla_procs[entrada].estado == NO_USADA || tabla_procs[entrada].id != id)
+		return NULL;
+	return &tabla_procs[entrada];
 }
 
 /*
  *
- * Funcion auxiliar que termina proceso actual liberando sus recursos.
- * Usada por llamada terminar_proceso y por rutinas que tratan excepciones
+ * Funciones de la reserva de pilas:
+ *	clase_pila obtener_pila devolver_pila
  *
  */
-static void liberar_proceso(){
-	printk("-> LIBERANDO PROCESO %d\n", p_proc_actual->id);
-	// Liberamos mutex abiertos
-	for(int i = 0; i < NUM_MUT_PROC; i++){
-		int mutexid = p_proc_actual->descriptores_mutex[i];
-		if(mutexid == NO_USADO) 
-			continue;
-		
-		escribir_registro(1, mutexid);
-		cerrar_mutex();
-	}
-	
-	BCP * p_proc_anterior;
-	liberar_imagen(p_proc_actual->info_mem); /* liberar mapa */
 
-	p_proc_actual->estado=TERMINADO;
-	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-	eliminar_primero(&lista_listos); /* proc. fuera de listos */
-	fijar_nivel_int(nivel_interrupcion_previo);
+/*
+ * Devuelve la clase de la reserva que corresponde a un tamao de pila
+ * (el de la menor potencia de 2 que lo contiene)
+ */
+static int clase_pila(int tam){
+	int clase = 0;
 
-	/* Realizar cambio de contexto */
-	p_proc_anterior=p_proc_actual;
-	p_proc_actual=planificador();
+	while ((TAM_PILA_MINIMA << clase) < tam && clase < NUM_CLASES_PILA-1)
+		clase++;
+	return clase;
+}
 
-	printk("-> C.CONTEXTO POR FIN: de %d a %d\n",
-			p_proc_anterior->id, p_proc_actual->id);
+/*
+ * Obtiene una pila del tamao indicado de la reserva o, si no hay
+ * ninguna guardada, la crea
+ */
+static void * obtener_pila(int tam){
+	int clase = clase_pila(tam);
 
-	liberar_pila(p_proc_anterior->pila);
-	cambio_contexto(NULL, &(p_proc_actual->contexto_regs));
-    return; /* no debera llegar aqui */
+	if (num_pilas_reserva[clase] > 0){
+		estadisticas_pilas.aciertos++;
+		estadisticas_pilas.en_reserva--;
+		return reserva_pilas[clase][--num_pilas_reserva[clase]];
+	}
+	estadisticas_pilas.fallos++;
+	return crear_pila(tam);
+}
+
+/*
+ * Guarda en la reserva la pila de un proceso que termina o, si la de su
+ * tamao esta llena, la libera
+ */
+static void devolver_pila(void *pila, int tam){
+	int clase = clase_pila(tam);
+
+	if (num_pilas_reserva[clase] < PILAS_POR_CLASE){
+		reserva_pilas[clase][num_pilas_reserva[clase]++] = pila;
+		estadisticas_pilas.en_reserva++;
+		return;
+	}
+	estadisticas_pilas.descartadas++;
+	liberar_pila(pila);
 }
 
 /*
  *
- * Funciones relacionadas con el tratamiento de interrupciones
- *	excepciones: exc_arit exc_mem
- *	interrupciones de reloj: int_reloj
- *	interrupciones del terminal: int_terminal
- *	llamadas al sistemas: llam_sis
- *	interrupciones SW: int_sw
+ * Funciones de la cache de imagenes:
+ *	cargar_imagen obtener_imagen soltar_imagen vaciar_cache_imagenes
  *
  */
 
 /*
- * Tratamiento de excepciones aritmeticas
+ * Carga la imagen de un programa con crear_imagen contabilizando el
+ * tiempo empleado
  */
-static void exc_arit(){
+static void * cargar_imagen(char *prog, void **pc_inicial){
+	unsigned long long inicio = leer_reloj_CMOS();
+	void *imagen = crear_imagen(prog, pc_inicial);
 
-	if (!viene_de_modo_usuario())
-		panico("excepcion aritmetica cuando estaba dentro del kernel");
+	estadisticas_imagenes.fallos++;
+	estadisticas_imagenes.ms_carga += leer_reloj_CMOS() - inicio;
+	return imagen;
+}
+
+/*
+ * Devuelve la imagen del programa y su punto de arranque, de la cache si
+ * esta en ella o cargandola y guardandola en una entrada libre o en la de
+ * la imagen sin procesos usada hace mas tiempo. Si todas las entradas
+ * estan en uso la imagen se carga sin guardarla.
+ */
+static void * obtener_imagen(char *prog, void **pc_inicial){
+	imagen_cache *entrada = NULL;
+	void *imagen;
+	int i;
 
+	if (!modo_cache_imagenes || strlen(prog) >= MAX_NOM_PROG)
+		return cargar_imagen(prog, pc_inicial);
+
+	for (i=0; i<NUM_IMAGENES_CACHE; i++){
+		imagen_cache *e = &cache_imagenes[i];
+		if (e->nombre[0] != '\0' && strcmp(e->nombre, prog) == 0){
+			estadisticas_imagenes.aciertos++;
+			e->referencias++;
+			e->ultimo_uso = ++usos_cache;
+			*pc_inicial = e->pc_inicial;
+			return e->imagen;
+		}
+		if (e->referencias == 0 && (entrada == NULL ||
+		    (entrada->nombre[0] != '\0' &&
+		     (e->nombre[0] == '\0' || e->ultimo_uso < entrada->ultimo_uso))))
+			entrada = e;
+	}
 
-	printk("-> EXCEPCION ARITMETICA EN PROC %d\n", p_proc_actual->id);
-	liberar_proceso();
+	imagen = cargar_imagen(prog, pc_inicial);
+	if (imagen == NULL || entrada == NULL)
+		return imagen;
 
-        return; /* no debera llegar aqui */
+	// Se expulsa la imagen que ocupaba la entrada (nunca es la ultima del
+	// HAL, que terminaria el sistema, ya que se acaba de cargar otra)
+	if (entrada->nombre[0] != '\0'){
+		printk("-> CACHE DE IMAGENES: EXPULSA %s\n", entrada->nombre);
+		estadisticas_imagenes.expulsiones++;
+		liberar_imagen(entrada->imagen);
+	}
+	strcpy(entrada->nombre, prog);
+	entrada->imagen = imagen;
+	entrada->pc_inicial = *pc_inicial;
+	entrada->referencias = 1;
+	entrada->ultimo_uso = ++usos_cache;
+	return imagen;
 }
 
 /*
- * Tratamiento de excepciones en el acceso a memoria
- * Si se accede a un parametro  de la zona de usuario, no se debe producir panico, sino que se aborta el proceso
+ * Indica que un proceso deja de usar su imagen. Si no esta en la cache se
+ * libera directamente.
  */
-static void exc_mem(){
-	if (!viene_de_modo_usuario() && zona_mem_proc_usuario == 0)
-		panico("excepcion de memoria cuando estaba dentro del kernel");
+static void soltar_imagen(void *imagen){
+	int i;
 
-	printk("-> EXCEPCION DE MEMORIA EN PROC %d\n", p_proc_actual->id);
-	liberar_proceso();
+	for (i=0; i<NUM_IMAGENES_CACHE; i++)
+		if (cache_imagenes[i].nombre[0] != '\0' && cache_imagenes[i].imagen == imagen){
+			cache_imagenes[i].referencias--;
+			return;
+		}
+	liberar_imagen(imagen);
+}
 
-    return; /* no debera llegar aqui */
+/*
+ * Libera todas las imagenes de la cache. Se usa cuando ya no quedan
+ * procesos, ya que el HAL termina el sistema al liberar la ultima imagen.
+ */
+static void vaciar_cache_imagenes(){
+	int i;
+
+	for (i=0; i<NUM_IMAGENES_CACHE; i++)
+		if (cache_imagenes[i].nombre[0] != '\0'){
+			cache_imagenes[i].nombre[0] = '\0';
+			liberar_imagen(cache_imagenes[i].imagen);
+		}
 }
 
 /*
- * Tratamiento de interrupciones de terminal
+ *
+ * Funciones que manejan el monticulo de listos de las politicas CFS y
+ * stride
+ *	usa_monticulo clave_monticulo colocar_monticulo subir_monticulo
+ *	bajar_monticulo insertar_monticulo eliminar_monticulo
+ *	actualizar_vruntime actualizar_paso
+ *
+ * Es un monticulo binario de minimos ordenado por vruntime (CFS) o por
+ * paso (stride). Cada BCP guarda su posicion, por lo que eliminarlo o
+ * recolocarlo es O(log n).
  */
-static void int_terminal(){
-	char car;
-	int nivel_terminal = fijar_nivel_int(NIVEL_2);
-	car = leer_puerto(DIR_TERMINAL);
-	printk("-> TRATANDO INT. DE TERMINAL %c\n", car);
 
-	// Si buffer lleno, no se hace nada
-	if (caracteres.length >= TAM_BUF_TERM) return;
+/*
+ * Indica si la politica actual guarda los listos en el monticulo
+ */
+static int usa_monticulo(){
+	return politica_planif == PLANIF_CFS || politica_planif == PLANIF_STRIDE;
+}
 
-	// Añadimos car al buffer porque hay hueco
-	caracteres.buffer[caracteres.puntero_escritura] = car;
-	caracteres.puntero_escritura = (caracteres.puntero_escritura + 1) % TAM_BUF_TERM;
-	printk("---> PROC %d: ACTUALIZACION PUNTERO ESCRITURA A %d \n", p_proc_actual->id, caracteres.puntero_escritura);
-	caracteres.length++;
-	printk("---> PROC %d: ACTUALIZACION LENGTH A %d \n", p_proc_actual->id, caracteres.length);
-	// // Si buffer estaba vacio, se despierta proceso bloqueado
-	if (caracteres.length == 1) {
-		BCP * p_proc = lista_bloq_caracter.primero;
-		if (p_proc == NULL) return;
-		p_proc->estado = LISTO;
-		int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-		eliminar_primero(&lista_bloq_caracter);
-		insertar_ultimo(&lista_listos, p_proc);
-		fijar_nivel_int(nivel_interrupcion_previo);
-	}
-	fijar_nivel_int(nivel_terminal);
-    return;
+/*
+ * Clave por la que se ordena el monticulo
+ */
+static long long clave_monticulo(BCP * proc){
+	return (politica_planif == PLANIF_STRIDE) ? proc->paso : proc->vruntime;
 }
 
 /*
- * Tratamiento de interrupciones de reloj
+ * Pone un proceso en una posicion del monticulo
  */
-static void int_reloj(){
-	num_int_reloj++;
-	//printk("-> TRATANDO INT. DE RELOJ Nº %d\n", num_int_reloj);
-	tratamiento_uso_procesador();
-	tratamiento_int_dormir();
-	tratamiento_round_robin();
-    return;
+static void colocar_monticulo(int pos, BCP * proc){
+	monticulo_listos[pos] = proc;
+	proc->pos_monticulo = pos;
 }
 
 /*
- * Tratamiento de llamadas al sistema
+ * Sube hacia la raiz el proceso de la posicion indicada mientras su
+ * clave sea menor que la de su padre
  */
-static void tratar_llamsis(){
-	int nserv, res;
+static void subir_monticulo(int pos){
+	BCPptr proc = monticulo_listos[pos];
+	int padre;
+
+	while (pos > 0){
+		padre = (pos-1)/2;
+		if (clave_monticulo(monticulo_listos[padre]) <= clave_monticulo(proc))
+			break;
+		colocar_monticulo(pos, monticulo_listos[padre]);
+		pos = padre;
+	}
+	colocar_monticulo(pos, proc);
+}
 
-	nserv=leer_registro(0);
-	if (nserv<NSERVICIOS)
-		res=(tabla_servicios[nserv].fservicio)();
-	else
-		res=-1;		/* servicio no existente */
-	escribir_registro(0,res);
-	return;
+/*
+ * Baja hacia las hojas el proceso de la posicion indicada mientras su
+ * clave sea mayor que la del menor de sus hijos
+ */
+static void bajar_monticulo(int pos){
+	BCPptr proc = monticulo_listos[pos];
+	int hijo;
+
+	while ((hijo = 2*pos+1) < tam_monticulo){
+		if (hijo+1 < tam_monticulo &&
+		    clave_monticulo(monticulo_listos[hijo+1]) < clave_monticulo(monticulo_listos[hijo]))
+			hijo++;
+		if (clave_monticulo(proc) <= clave_monticulo(monticulo_listos[hijo]))
+			break;
+		colocar_monticulo(pos, monticulo_listos[hijo]);
+		pos = hijo;
+	}
+	colocar_monticulo(pos, proc);
 }
 
 /*
-*	
-*/
+ * Inserta un proceso en el monticulo. Si viene de estar bloqueado mucho
+ * tiempo, su vruntime se acerca a min_vruntime (su paso a paso_global)
+ * para que no acapare el procesador hasta alcanzar a los demas.
+ */
+static void insertar_monticulo(BCP * proc){
+	long long minimo = min_vruntime - (long long)LATENCIA_CFS*VRUNTIME_POR_TICK/2;
+
+	if (proc->vruntime < minimo)
+		proc->vruntime = minimo;
+	if (proc->paso < paso_global)
+		proc->paso = paso_global;
+	colocar_monticulo(tam_monticulo, proc);
+	tam_monticulo++;
+	subir_monticulo(proc->pos_monticulo);
+	peso_total_listos += proc->peso;
+}
 
 /*
- * Tratamiento de interrupciones software
+ * Elimina un proceso del monticulo poniendo el ultimo en su lugar
  */
-static void int_sw(){
-	printk("-> TRATANDO INT. SW\n");
-	if(p_proc_actual->id == id_proc_a_expulsar){
-		printk("-> EXPULSANDO PROCESO %d\n", p_proc_actual->id);
-		BCPptr p_proc = lista_listos.primero;
-		int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-		eliminar_primero(&lista_listos);
-		insertar_ultimo(&lista_listos, p_proc);
-		fijar_nivel_int(nivel_interrupcion_previo);
-		// CCI
-		p_proc = p_proc_actual;
-		p_proc_actual = planificador();
-		cambio_contexto(&(p_proc->contexto_regs), &(p_proc_actual->contexto_regs));
-	}
+static void eliminar_monticulo(BCP * proc){
+	int pos = proc->pos_monticulo;
+	BCPptr ultimo;
+
+	tam_monticulo--;
+	peso_total_listos -= proc->peso;
+	if (pos == tam_monticulo)
+		return;
+	ultimo = monticulo_listos[tam_monticulo];
+	colocar_monticulo(pos, ultimo);
+	subir_monticulo(pos);
+	bajar_monticulo(ultimo->pos_monticulo);
+}
 
-	return;
+/*
+ * Carga a un proceso del monticulo ticks ticks de ejecucion ponderados
+ * por su peso y lo recoloca
+ */
+static void actualizar_vruntime(BCP * proc, int ticks){
+	proc->vruntime += (long long)ticks*VRUNTIME_POR_TICK*PESO_NICE_0/proc->peso;
+	bajar_monticulo(proc->pos_monticulo);
+	if (monticulo_listos[0]->vruntime > min_vruntime)
+		min_vruntime = monticulo_listos[0]->vruntime;
+}
+
+/*
+ * Avanza el paso de un proceso del monticulo segun su zancada por los
+ * ticks ejecutados y lo recoloca
+ */
+static void actualizar_paso(BCP * proc, int ticks){
+	proc->paso += (long long)ticks*proc->zancada;
+	bajar_monticulo(proc->pos_monticulo);
+	if (monticulo_listos[0]->paso > paso_global)
+		paso_global = monticulo_listos[0]->paso;
 }
 
 /*
  *
- * Funcion auxiliar que crea un proceso reservando sus recursos.
- * Usada por llamada crear_proceso.
+ * Funciones que manejan las colas de listos por prioridad
+ *	insertar_listo insertar_listo_primero eliminar_listo primer_listo
+ *	rotar_listo cambiar_nivel_listo
  *
+ * El proceso en ejecucion permanece en la cola de su nivel. El mapa de
+ * bits mapa_listos tiene activo el bit de cada nivel no vacio, de manera
+ * que elegir el siguiente proceso no depende del numero de listos.
+ * Con las politicas CFS y stride los listos estan en el monticulo en vez
+ * de en las colas. Los de tiempo real con presupuesto estan en listos_tr, que se
+ * consulta antes.
  */
-static int crear_tarea(char *prog){
-	void * imagen, *pc_inicial;
-	int error=0;
-	int proc;
-	BCP *p_proc;
-
-	proc=buscar_BCP_libre();
-	if (proc==-1)
-		return -1;	/* no hay entrada libre */
+
+/*
+ * Indica si un proceso debe planificarse en la clase de tiempo real
+ */
+static int es_edf(BCP * proc){
+	return proc->tiempo_real && proc->presupuesto_restante > 0;
+}
+
+/*
+ * Inserta un proceso al final de la cola de listos de su prioridad
+ */
+static void insertar_listo(BCP * proc){
+	proc->en_edf = es_edf(proc);
+	if (proc->en_edf)
+		insertar_por_plazo(&listos_tr, proc);
+	else if (usa_monticulo())
+		insertar_monticulo(proc);
+	else {
+		insertar_ultimo(&listas_listos[proc->prioridad], proc);
+		mapa_listos |= 1U << proc->prioridad;
+	}
+	num_listos++;
+}
+
+/*
+ * Inserta un proceso al principio de la cola de listos de su prioridad
+ */
+static void insertar_listo_primero(BCP * proc){
+	proc->en_edf = es_edf(proc);
+	if (proc->en_edf)
+		insertar_por_plazo(&listos_tr, proc);
+	else if (usa_monticulo())
+		insertar_monticulo(proc);
+	else {
+		insertar_primero(&listas_listos[proc->prioridad], proc);
+		mapa_listos |= 1U << proc->prioridad;
+	}
+	num_listos++;
+}
+
+/*
+ * Elimina un proceso de la cola de listos de su prioridad
+ */
+static void eliminar_listo(BCP * proc){
+	lista_BCPs *lista = &listas_listos[proc->prioridad];
+
+	if (proc->en_edf)
+		eliminar_elem(&listos_tr, proc);
+	else if (usa_monticulo())
+		eliminar_monticulo(proc);
+	else {
+		eliminar_elem(lista, proc);
+		if (lista->primero==NULL)
+			mapa_listos &= ~(1U << proc->prioridad);
+	}
+	num_listos--;
+}
+
+/*
+ * Devuelve el proceso de tiempo real de plazo mas cercano o, si no hay, el
+ * primero del nivel no vacio mas prioritario (con CFS y stride, el de
+ * menor clave). Devuelve NULL si no hay procesos listos.
+ */
+static BCP * primer_listo(){
+	int nivel;
+
+	if (listos_tr.primero != NULL)
+		return listos_tr.primero;
+	if (usa_monticulo())
+		return (tam_monticulo > 0) ? monticulo_listos[0] : NULL;
+	if (mapa_listos == 0)
+		return NULL;
+	nivel = (int)(sizeof(mapa_listos)*8 - 1) - __builtin_clz(mapa_listos);
+	return listas_listos[nivel].primero;
+}
+
+/*
+ * Pasa un proceso al final de la cola de su nivel (Round Robin dentro
+ * del nivel)
+ */
+static void rotar_listo(BCP * proc){
+	eliminar_listo(proc);
+	insertar_listo(proc);
+}
+
+/*
+ * Pasa un proceso listo al final de la cola del nivel indicado
+ */
+static void cambiar_nivel_listo(BCP * proc, int prioridad){
+	eliminar_listo(proc);
+	proc->prioridad = prioridad;
+	insertar_listo(proc);
+}
+
+/*
+ *
+ * Funciones relacionadas con la rueda de plazos
+ *	insertar_rueda programar_plazo cancelar_plazo cascada_rueda
+ *	ticks_hasta_plazo ms_a_ticks
+ *
+ * Cada proceso en la rueda esta en una lista doblemente enlazada (por
+ * sig_plazo y ant_plazo) de la cubeta que corresponde a su tick de
+ * vencimiento. Si el plazo esta a menos de TAM_RUEDA ticks va al nivel 0;
+ * si no, a un nivel superior, y baja de nivel (cascada) cuando el nivel
+ * inferior completa una vuelta.
+ */
+
+/*
+ * Inserta un proceso en la cubeta correspondiente a su tick de vencimiento
+ */
+static void insertar_rueda(BCP * proc){
+	BCPptr *cubeta;
+	int vence = proc->despertar;
+	int delta = vence - tick_rueda;
+	int nivel;
+
+	if (delta < 0){			/* ya ha vencido: se trata en el siguiente tick */
+		vence = tick_rueda;
+		delta = 0;
+	}
+	else if (delta >= MAX_PLAZO_RUEDA){	/* se reinsertara al bajar de nivel */
+		vence = tick_rueda + MAX_PLAZO_RUEDA - 1;
+		delta = MAX_PLAZO_RUEDA - 1;
+	}
+	for (nivel = 0; delta >= (1 << (BITS_RUEDA*(nivel+1))); nivel++);
+
+	cubeta = &rueda_plazos[nivel][(vence >> (BITS_RUEDA*nivel)) & (TAM_RUEDA-1)];
+	proc->sig_plazo = *cubeta;
+	if (*cubeta != NULL)
+		(*cubeta)->ant_plazo = &proc->sig_plazo;
+	proc->ant_plazo = cubeta;
+	*cubeta = proc;
+}
+
+/*
+ * Anota en la rueda que el proceso debe despertar dentro de ticks ticks
+ */
+static void programar_plazo(BCP * proc, int ticks){
+	proc->despertar = num_int_reloj + ticks;
+	insertar_rueda(proc);
+	num_plazos++;
+}
+
+/*
+ * Saca de la rueda a un proceso antes de que venza su plazo
+ */
+static void cancelar_plazo(BCP * proc){
+	if (proc->ant_plazo == NULL)
+		return;
+	*proc->ant_plazo = proc->sig_plazo;
+	if (proc->sig_plazo != NULL)
+		proc->sig_plazo->ant_plazo = proc->ant_plazo;
+	proc->ant_plazo = NULL;
+	num_plazos--;
+}
+
+/*
+ * Redistribuye en los niveles inferiores la cubeta del nivel indicado que
+ * corresponde al tick actual. Devuelve el indice de la cubeta: si es 0,
+ * tambien hay que bajar la del nivel siguiente.
+ */
+static int cascada_rueda(int nivel){
+	int indice = (tick_rueda >> (BITS_RUEDA*nivel)) & (TAM_RUEDA-1);
+	BCPptr p_proc = rueda_plazos[nivel][indice];
+	BCPptr siguiente;
+
+	rueda_plazos[nivel][indice] = NULL;
+	for ( ; p_proc != NULL; p_proc = siguiente){
+		siguiente = p_proc->sig_plazo;
+		insertar_rueda(p_proc);
+	}
+	return indice;
+}
+
+/*
+ * Devuelve cuantos ticks faltan, como mucho limite, hasta el primer tick
+ * en el que la rueda puede despertar a algun proceso. Un cambio de vuelta
+ * del nivel 0 se considera un posible vencimiento, porque puede bajar
+ * procesos de los niveles superiores.
+ */
+static int ticks_hasta_plazo(int limite){
+	int i, tick;
+
+	if (num_plazos == 0)
+		return limite;
+	for (i = 0; i < limite; i++){
+		tick = tick_rueda + i;
+		if ((tick & (TAM_RUEDA-1)) == 0 ||
+		    rueda_plazos[0][tick & (TAM_RUEDA-1)] != NULL)
+			return i + 1;
+	}
+	return limite;
+}
+
+/*
+ * Pasa milisegundos a ticks redondeando hacia arriba
+ */
+static int ms_a_ticks(unsigned int milisegs){
+	return (int)(((unsigned long long)milisegs*TICK + 999) / 1000);
+}
+
+/*
+ *
+ * Funciones de las estadisticas del planificador
+ *	intervalo_latencia anotar_listo anotar_ejecucion
+ */
+
+/*
+ * Devuelve el intervalo del histograma que corresponde a una latencia
+ */
+static int intervalo_latencia(unsigned long long ms){
+	int i = 0;
+
+	for ( ; ms > 0 && i < NUM_INTERVALOS_LATENCIA-1; ms >>= 1)
+		i++;
+	return i;
+}
+
+/*
+ * Anota el instante en que un proceso pasa a listo y la longitud de la
+ * cola de listos que encuentra (incluido el)
+ */
+static void anotar_listo(BCP * proc){
+	int longitud = (num_listos < NUM_LONG_COLA) ? num_listos : NUM_LONG_COLA-1;
+
+	proc->ms_listo = leer_reloj_CMOS();
+	proc->esperando_ejecutar = 1;
+	proc->estadisticas.long_cola[longitud]++;
+}
+
+/*
+ * Si el proceso elegido por el planificador estaba esperando desde que
+ * paso a listo, anota su latencia
+ */
+static void anotar_ejecucion(BCP * proc){
+	int i;
+
+	if (!proc->esperando_ejecutar)
+		return;
+	proc->esperando_ejecutar = 0;
+	i = intervalo_latencia(leer_reloj_CMOS() - proc->ms_listo);
+	proc->estadisticas.latencia[i]++;
+	estadisticas_sistema.latencia[i]++;
+}
+
+/*
+ *
+ * Funciones relacionadas con el reloj sin ticks
+ *	contabilizar_ticks programar_reloj ajustar_reloj reprogramar_reloj
+ *
+ * Si hay varios procesos listos el reloj interrumpe TICK veces por
+ * segundo. Si no hay ninguno o solo hay uno, se programa para interrumpir
+ * en el plazo mas cercano (fin de dormir, fin de rodaja, elevacion MLFQ)
+ * y cada interrupcion contabiliza de golpe los ticks_por_int ticks
+ * transcurridos. Como el HAL solo permite fijar una frecuencia,
+ * ticks_por_int es siempre un divisor de TICK.
+ */
+
+/*
+ * Trata los ticks transcurridos desde la ultima contabilizacion
+ */
+static void contabilizar_ticks(int ticks){
+	contabilizando_ticks = 1;
+	num_int_reloj += ticks;
+	estadisticas_sistema.long_cola[(num_listos < NUM_LONG_COLA) ? num_listos : NUM_LONG_COLA-1] += ticks;
+	tratamiento_uso_procesador(ticks);
+	// Los ticks son del que estaba ejecutando, no del que despierte ahora
+	tratamiento_tiempo_real(ticks);
+	tratamiento_round_robin(ticks);
+	tratamiento_int_dormir();
+	tratamiento_elevacion_mlfq();
+	contabilizando_ticks = 0;
+}
+
+/*
+ * Elige cuantos ticks representara la siguiente interrupcion de reloj
+ * y, si cambia, reprograma el controlador
+ */
+static void programar_reloj(){
+	int ticks = 1;
+	BCPptr p_proc;
+
+	if (modo_sin_ticks && num_listos <= 1){
+		ticks = ticks_hasta_plazo(TICK);
+		p_proc = primer_listo();
+		if (p_proc != NULL && p_proc->vida < ticks)
+			ticks = p_proc->vida;
+		if (p_proc != NULL && p_proc->en_edf && p_proc->presupuesto_restante < ticks)
+			ticks = p_proc->presupuesto_restante;
+		if (politica_planif == PLANIF_MLFQ && proxima_elevacion - num_int_reloj < ticks)
+			ticks = proxima_elevacion - num_int_reloj;
+		if (ticks < 1)
+			ticks = 1;
+		while (TICK % ticks != 0)
+			ticks--;
+	}
+
+	if (ticks != ticks_por_int){
+		ticks_por_int = ticks;
+		iniciar_cont_reloj(TICK / ticks);
+	}
+}
+
+/*
+ * Termina antes de tiempo el periodo largo en curso (p.ej. porque ya hay
+ * mas de un proceso listo): contabiliza los ticks que ya han transcurrido,
+ * medidos con el reloj CMOS, y vuelve a programar el reloj
+ */
+static void ajustar_reloj(){
+	int nivel_interrupcion_previo;
+	unsigned long long ahora;
+	int transcurridos;
+
+	if (ticks_por_int == 1 || contabilizando_ticks)
+		return;
+
+	nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	ahora = leer_reloj_CMOS();
+	transcurridos = (int)((ahora - ms_ultima_int) * TICK / 1000);
+	if (transcurridos >= ticks_por_int)
+		transcurridos = ticks_por_int - 1; /* la interrupcion ya esta pendiente */
+
+	// Lo que no llega a un tick se contara en la siguiente: si no, un proceso
+	// que consulte sus tiempos sin parar impediria que avance el reloj
+	ms_ultima_int += (unsigned long long) transcurridos * 1000 / TICK;
+	ticks_por_int = 1;
+	iniciar_cont_reloj(TICK);
+	if (transcurridos > 0)
+		contabilizar_ticks(transcurridos);
+	programar_reloj();
+	fijar_nivel_int(nivel_interrupcion_previo);
+}
+
+/*
+ * Vuelve a programar el reloj tras cambiar el numero de procesos listos,
+ * lo que debe ir precedido de ajustar_reloj para que los ticks del
+ * periodo en curso se contabilicen con los listos que habia. Mientras se
+ * contabilizan ticks no hace nada, ya que se programa al terminar.
+ */
+static void reprogramar_reloj(){
+	if (!contabilizando_ticks)
+		programar_reloj();
+}
+
+/*
+ *
+ * Funciones relacionadas con la planificacion
+ *	espera_int planificador comprobar_expulsion bloquear_proceso
+ *	desbloquear_proceso esperar_plazo
+ */
+
+/*
+ * Espera a que se produzca una interrupcion
+ */
+static void espera_int(){
+	int nivel;
+
+	//printk("-> NO HAY LISTOS. ESPERA INT\n");
+
+	/* Baja al mnimo el nivel de interrupcin mientras espera */
+	nivel=fijar_nivel_int(NIVEL_1);
+	halt();
+	fijar_nivel_int(nivel);
+}
+
+/*
+ * Funcin de planificacion que implementa un algoritmo Round-Robin
+ * dentro de cada nivel de prioridad.
+ */
+static BCP * planificador(){
+	BCPptr p_proc;
+
+	while ((p_proc = primer_listo()) == NULL)
+		espera_int();		/* No hay nada que hacer */
+	anotar_ejecucion(p_proc);
+	id_proc_en_ejecucion = p_proc->id;
+
+	// Cualquier proceso que entre a ejecutar, debera tener la rodaja completa.
+	// En CFS es su parte de LATENCIA_CFS segun su peso y el de los demas listos;
+	// los de tiempo real no estan en el monticulo, que puede estar vacio
+	if (politica_planif == PLANIF_CFS && !p_proc->en_edf && peso_total_listos > 0){
+		p_proc->vida = LATENCIA_CFS * p_proc->peso / peso_total_listos;
+		if (p_proc->vida < GRANULARIDAD_CFS)
+			p_proc->vida = GRANULARIDAD_CFS;
+	}
+	else
+		p_proc->vida = p_proc->rodaja;
+
+	return p_proc;
+}
+
+/*
+ * Si el proceso que acaba de pasar a listo es mas prioritario que el
+ * actual (con CFS, si su vruntime es menor por mas de GRANULARIDAD_CFS
+ * ticks; en tiempo real, si su plazo vence antes), se solicita la
+ * expulsion de este mediante una interrupcion SW
+ */
+static void comprobar_expulsion(BCP * proc){
+	int expulsar;
+
+	if (p_proc_actual == NULL || p_proc_actual->estado != LISTO)
+		return;
+	if (proc->en_edf || p_proc_actual->en_edf)
+		expulsar = proc->en_edf && (!p_proc_actual->en_edf ||
+			proc->plazo_absoluto < p_proc_actual->plazo_absoluto);
+	else if (politica_planif == PLANIF_CFS)
+		expulsar = proc->vruntime + GRANULARIDAD_CFS*VRUNTIME_POR_TICK <
+			p_proc_actual->vruntime;
+	else if (politica_planif == PLANIF_STRIDE)
+		expulsar = 0;	/* espera al fin de la rodaja del actual */
+	else
+		expulsar = proc->prioridad > p_proc_actual->prioridad;
+	if (expulsar){
+		id_proc_a_expulsar = p_proc_actual->id;
+		activar_int_SW();
+	}
+}
+
+/*
+ * Bloquea el proceso actual en la lista indicada (NULL si solo espera en
+ * la rueda de plazos) y cede el procesador. Retorna cuando el proceso
+ * vuelve a ser elegido por el planificador.
+ */
+static void bloquear_proceso(lista_BCPs *lista){
+	BCPptr p_proc = p_proc_actual;
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+
+	// Lo que ha ejecutado en el periodo largo del reloj se le contabiliza antes
+	ajustar_reloj();
+	p_proc->estado = BLOQUEADO;
+	eliminar_listo(p_proc);
+	p_proc->lista_espera = lista;
+	if (lista != NULL)
+		insertar_ultimo(lista, p_proc);
+	// MLFQ: si se bloquea antes de agotar su rodaja, despertara un nivel mas arriba
+	if (politica_planif == PLANIF_MLFQ && p_proc->vida > 0 &&
+	    p_proc->prioridad < NUM_PRIORIDADES-1)
+		p_proc->prioridad++;
+	// Si se bloquea sin haber usado media rodaja, en modo adaptativo se reduce
+	if (p_proc->vida*2 > p_proc->rodaja){
+		p_proc->bloqueos_tempranos++;
+		if (p_proc->rodaja_adaptativa && p_proc->rodaja/2 >= RODAJA_MINIMA)
+			p_proc->rodaja /= 2;
+	}
+	reprogramar_reloj();
+	fijar_nivel_int(nivel_interrupcion_previo);
+
+	// Cambio contexto voluntario
+	p_proc->estadisticas.cambios_voluntarios++;
+	estadisticas_sistema.cambios_voluntarios++;
+	p_proc_actual = planificador();
+	cambio_contexto(&(p_proc->contexto_regs), &(p_proc_actual->contexto_regs));
+}
+
+/*
+ * Pasa a listo un proceso bloqueado en la lista indicada (NULL si solo
+ * esperaba en la rueda de plazos). Si ademas tenia un plazo, se cancela.
+ */
+static void desbloquear_proceso(lista_BCPs *lista, BCP * proc){
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+
+	// Lo transcurrido en el periodo largo del reloj (inactivo si no habia
+	// listos) no se contabiliza al que se desbloquea
+	ajustar_reloj();
+	proc->estado = LISTO;
+	if (lista != NULL)
+		eliminar_elem(lista, proc);
+	proc->lista_espera = NULL;
+	cancelar_plazo(proc);
+	insertar_listo(proc);
+	anotar_listo(proc);
+	comprobar_expulsion(proc);
+	// Con mas de un proceso listo el reloj vuelve a su frecuencia normal
+	reprogramar_reloj();
+	fijar_nivel_int(nivel_interrupcion_previo);
+}
+
+/*
+ * Libera la entrada de un proceso y, si hay procesos esperando una entrada
+ * libre para crear otro, despierta al primero
+ */
+static void liberar_entrada(BCP * proc){
+	liberar_BCP(proc);
+	if (espera_BCP_libre.primero != NULL)
+		desbloquear_proceso(&espera_BCP_libre, espera_BCP_libre.primero);
+}
+
+/*
+ * Bloquea el proceso actual en la lista indicada (NULL si solo espera el
+ * plazo) hasta que lo desbloqueen o pasen ticks ticks, lo que ocurra
+ * antes. El plazo vence en la interrupcion de reloj numero
+ * num_int_reloj+ticks; como el tick en curso ya ha empezado, la espera
+ * real esta entre ticks-1 y ticks periodos de reloj.
+ */
+static void esperar_plazo(lista_BCPs *lista, int ticks){
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+
+	// En un periodo largo del reloj sin ticks se pone al dia num_int_reloj
+	ajustar_reloj();
+	programar_plazo(p_proc_actual, ticks);
+	// Si el plazo vence antes que el periodo largo del reloj, se acorta
+	if (ticks < ticks_por_int)
+		ajustar_reloj();
+	bloquear_proceso(lista);
+	fijar_nivel_int(nivel_interrupcion_previo);
+}
+
+/*
+ * Funciones auxiliares que mantienen la lista de hijos de cada proceso,
+ * enlazada por sig_hermano y ant_hermano, para no recorrer la tabla de
+ * procesos cuando termina.
+ */
+static void insertar_hijo(BCP *padre, BCP *hijo){
+	hijo->padre = padre;
+	hijo->sig_hermano = padre->primer_hijo;
+	if (padre->primer_hijo != NULL)
+		padre->primer_hijo->ant_hermano = &hijo->sig_hermano;
+	padre->primer_hijo = hijo;
+	hijo->ant_hermano = &padre->primer_hijo;
+	padre->num_hijos++;
+}
+
+static void quitar_hijo(BCP *hijo){
+	*hijo->ant_hermano = hijo->sig_hermano;
+	if (hijo->sig_hermano != NULL)
+		hijo->sig_hermano->ant_hermano = hijo->ant_hermano;
+	hijo->ant_hermano = NULL;
+	hijo->padre->num_hijos--;
+	hijo->padre = NULL;
+}
+
+/*
+ *
+ * Funcion auxiliar que resuelve la relacion de un proceso que termina con
+ * su padre y sus hijos. Sus hijos se quedan sin padre (los que ya han
+ * terminado se liberan) y el se queda ZOMBI con su valor de terminacion
+ * hasta que su padre lo recoja, despertandolo si le estaba esperando. Si
+ * no tiene padre se libera. Se llama con las interrupciones inhibidas.
+ *
+ */
+static void terminar_relaciones(BCP *p_proc, int estado){
+	BCP *padre = p_proc->padre;
+	BCP *hijo;
+
+	while ((hijo = p_proc->primer_hijo) != NULL){
+		quitar_hijo(hijo);
+		if (hijo->estado == ZOMBI)
+			liberar_entrada(hijo);
+	}
+	p_proc->hijos_terminados.primero = p_proc->hijos_terminados.ultimo = NULL;
+
+	if (padre == NULL){
+		liberar_entrada(p_proc); /* TERMINADO y entrada a la lista de libres */
+		return;
+	}
+	p_proc->estado = ZOMBI;
+	p_proc->estado_fin = estado;
+	insertar_ultimo(&padre->hijos_terminados, p_proc);
+	if (padre->lista_espera == &padre->espera_hijos)
+		desbloquear_proceso(&padre->espera_hijos, padre);
+}
+
+/*
+ *
+ * Funcion auxiliar que deja de usar la imagen de un proceso. Solo se
+ * libera si no la comparte con otros hilos o procesos creados a la vez
+ * con crear_procesos o es el ultimo de ellos.
+ * Usada por liberar_proceso y por la llamada ejecutar.
+ *
+ */
+static void soltar_imagen_proceso(BCP *p_proc){
+	if (p_proc->hilos_imagen == NULL || --*p_proc->hilos_imagen == 0){
+		free(p_proc->hilos_imagen);
+		soltar_imagen(p_proc->info_mem);
+	}
+	p_proc->hilos_imagen = NULL;
+}
+
+/*
+ *
+ * Funcion auxiliar que termina proceso actual liberando sus recursos.
+ * Usada por llamada terminar_proceso y por rutinas que tratan excepciones
+ *
+ */
+static void liberar_proceso(int estado){
+	printk("-> LIBERANDO PROCESO %d\n", p_proc_actual->id);
+	// Liberamos mutex abiertos. Si otros hilos comparten la tabla, siguen
+	// abiertos y solo se suelta lo que tiene este
+	descriptores_mutex *tabla = p_proc_actual->mutex_abiertos;
+	int ultimo = (--tabla->n_hilos == 0);
+	for(int i = 0; i < NUM_MUT_PROC; i++){
+		int mutexid = tabla->descriptores[i];
+		if(mutexid == NO_USADO) 
+			continue;
+		
+		if(!ultimo){
+			soltar_lo_propio(mutexid, i);
+			continue;
+		}
+		escribir_registro(1, mutexid);
+		cerrar_mutex();
+	}
+	if(tabla != &p_proc_actual->mutex_propios){
+		if(ultimo)
+			free(tabla);
+		p_proc_actual->mutex_abiertos = &p_proc_actual->mutex_propios;
+	}
+	
+	BCP * p_proc_anterior;
+	soltar_imagen_proceso(p_proc_actual); /* liberar mapa */
+	if (--num_procesos == 0)
+		vaciar_cache_imagenes(); /* el HAL termina el sistema */
+
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	ajustar_reloj(); /* contabiliza lo que ha ejecutado */
+	eliminar_listo(p_proc_actual); /* proc. fuera de listos */
+	cancelar_plazo(p_proc_actual); /* y fuera de la rueda si tuviera plazo */
+	if (p_proc_actual->tiempo_real) /* devuelve su utilizacion */
+		utilizacion_tr -= p_proc_actual->utilizacion;
+	terminar_relaciones(p_proc_actual, estado); /* ZOMBI o libre */
+	reprogramar_reloj();
+	fijar_nivel_int(nivel_interrupcion_previo);
+
+	/* Realizar cambio de contexto */
+	p_proc_anterior=p_proc_actual;
+	p_proc_actual=planificador();
+
+	printk("-> C.CONTEXTO POR FIN: de %d a %d\n",
+			p_proc_anterior->id, p_proc_actual->id);
+
+	devolver_pila(p_proc_anterior->pila, p_proc_anterior->tam_pila);
+	cambio_contexto(NULL, &(p_proc_actual->contexto_regs));
+    return; /* no debera llegar aqui */
+}
+
+/*
+ *
+ * Funciones relacionadas con el tratamiento de interrupciones
+ *	excepciones: exc_arit exc_mem
+ *	interrupciones de reloj: int_reloj
+ *	interrupciones del terminal: int_terminal
+ *	llamadas al sistemas: llam_sis
+ *	interrupciones SW: int_sw
+ *
+ */
+
+/*
+ * Tratamiento de excepciones aritmeticas
+ */
+static void exc_arit(){
+
+	if (!viene_de_modo_usuario())
+		panico("excepcion aritmetica cuando estaba dentro del kernel");
+
+
+	printk("-> EXCEPCION ARITMETICA EN PROC %d\n", p_proc_actual->id);
+	liberar_proceso(ESTADO_EXCEPCION);
+
+        return; /* no debera llegar aqui */
+}
+
+/*
+ * Tratamiento de excepciones en el acceso a memoria
+ * Si se accede a un parametro  de la zona de usuario, no se debe producir panico, sino que se aborta el proceso
+ */
+static void exc_mem(){
+	if (!viene_de_modo_usuario() && zona_mem_proc_usuario == 0)
+		panico("excepcion de memoria cuando estaba dentro del kernel");
+
+	printk("-> EXCEPCION DE MEMORIA EN PROC %d\n", p_proc_actual->id);
+	zona_mem_proc_usuario = 0;
+	liberar_proceso(ESTADO_EXCEPCION);
+
+    return; /* no debera llegar aqui */
+}
+
+/*
+ * Tratamiento de interrupciones de terminal
+ */
+static void int_terminal(){
+	char car;
+	int nivel_terminal = fijar_nivel_int(NIVEL_2);
+	car = leer_puerto(DIR_TERMINAL);
+	printk("-> TRATANDO INT. DE TERMINAL %c\n", car);
+
+	// Si buffer lleno, no se hace nada
+	if (caracteres.length >= TAM_BUF_TERM) return;
+
+	// Añadimos car al buffer porque hay hueco
+	caracteres.buffer[caracteres.puntero_escritura] = car;
+	caracteres.puntero_escritura = (caracteres.puntero_escritura + 1) % TAM_BUF_TERM;
+	printk("---> PROC %d: ACTUALIZACION PUNTERO ESCRITURA A %d \n", p_proc_actual->id, caracteres.puntero_escritura);
+	caracteres.length++;
+	printk("---> PROC %d: ACTUALIZACION LENGTH A %d \n", p_proc_actual->id, caracteres.length);
+	// // Si buffer estaba vacio, se despierta proceso bloqueado
+	if (caracteres.length == 1) {
+		BCP * p_proc = lista_bloq_caracter.primero;
+		if (p_proc == NULL) return;
+		desbloquear_proceso(&lista_bloq_caracter, p_proc);
+	}
+	fijar_nivel_int(nivel_terminal);
+    return;
+}
+
+/*
+ * Tratamiento de interrupciones de reloj
+ */
+static void int_reloj(){
+	//printk("-> TRATANDO INT. DE RELOJ Nº %d\n", num_int_reloj);
+	if (modo_sin_ticks)
+		ms_ultima_int = leer_reloj_CMOS();
+	contabilizar_ticks(ticks_por_int);
+	programar_reloj();
+    return;
+}
+
+/*
+ * Tratamiento de llamadas al sistema
+ */
+static void tratar_llamsis(){
+	int nserv, res;
+
+	nserv=leer_registro(0);
+	if (nserv<NSERVICIOS)
+		res=(tabla_servicios[nserv].fservicio)();
+	else
+		res=-1;		/* servicio no existente */
+	escribir_registro(0,res);
+	return;
+}
+
+/*
+*	
+*/
+
+/*
+ * Tratamiento de interrupciones software
+ */
+static void int_sw(){
+	printk("-> TRATANDO INT. SW\n");
+	if(p_proc_actual->id == id_proc_a_expulsar){
+		printk("-> EXPULSANDO PROCESO %d\n", p_proc_actual->id);
+		BCPptr p_proc = p_proc_actual;
+		int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+		id_proc_a_expulsar = NO_USADO;
+		// Si ha agotado su rodaja pasa al final de su nivel (en MLFQ al del
+		// nivel inferior). Si le expulsa uno mas prioritario conserva su posicion
+		if (p_proc->vida <= 0){
+			// Ha usado la rodaja completa: en modo adaptativo se amplia
+			p_proc->rodajas_agotadas++;
+			if (p_proc->rodaja_adaptativa)
+				p_proc->rodaja = (p_proc->rodaja*2 <= RODAJA_MAXIMA) ?
+					p_proc->rodaja*2 : RODAJA_MAXIMA;
+			if (politica_planif == PLANIF_MLFQ && p_proc->prioridad > 0)
+				cambiar_nivel_listo(p_proc, p_proc->prioridad - 1);
+			else
+				rotar_listo(p_proc);
+		}
+		fijar_nivel_int(nivel_interrupcion_previo);
+		// CCI
+		p_proc_actual = planificador();
+		if (p_proc_actual != p_proc){
+			p_proc->estadisticas.cambios_involuntarios++;
+			estadisticas_sistema.cambios_involuntarios++;
+		}
+		cambio_contexto(&(p_proc->contexto_regs), &(p_proc_actual->contexto_regs));
+	}
+
+	return;
+}
+
+/*
+ *
+ * Funcion auxiliar que rellena el BCP de un proceso nuevo con su imagen,
+ * su pila y los atributos que hereda de su creador.
+ * Usada por crear_tarea y crear_procesos.
+ *
+ */
+static void iniciar_BCP(BCP *p_proc, void *imagen, void *pc_inicial){
+	p_proc->info_mem=imagen;
+	p_proc->hilos_imagen=NULL;
+	p_proc->funcion_hilo=NULL;
+	// Pila del tamao fijado por el creador, que tambien se hereda
+	p_proc->tam_pila = (p_proc_actual != NULL) ? p_proc_actual->tam_pila_hijos : TAM_PILA;
+	p_proc->tam_pila_hijos = p_proc->tam_pila;
+	p_proc->pila=obtener_pila(p_proc->tam_pila);
+	fijar_contexto_ini(p_proc->info_mem, p_proc->pila, p_proc->tam_pila, pc_inicial, &(p_proc->contexto_regs));
+	p_proc->id=(p_proc - tabla_procs) | (p_proc->generacion << BITS_ENTRADA_PID);
+	p_proc->estado=LISTO;
+
+	// Relacion con el creador, que puede esperar a que termine
+	p_proc->padre = NULL;
+	p_proc->ant_hermano = NULL;
+	if (p_proc_actual != NULL)
+		insertar_hijo(p_proc_actual, p_proc);
+	p_proc->num_hijos = 0;
+	p_proc->primer_hijo = NULL;
+	p_proc->hijos_terminados.primero = p_proc->hijos_terminados.ultimo = NULL;
+	p_proc->espera_hijos.primero = p_proc->espera_hijos.ultimo = NULL;
+	
+	// Dormir
+	p_proc->ant_plazo = NULL;
+	p_proc->lista_espera = NULL;
+
+	// Tiempos proceso
+	p_proc->tiempo_usuario = 0;
+	p_proc->tiempo_sistema = 0;
+
+	// Mutex
+	for(int i = 0; i < NUM_MUT_PROC; i++){
+		p_proc->mutex_propios.descriptores[i] = NO_USADO;
+		p_proc->mutex_propios.lecturas[i] = 0;
+		p_proc->lecturas_rwlock[i] = 0;
+	}
+	p_proc->mutex_propios.num_mutex = 0;
+	p_proc->mutex_propios.n_hilos = 1;
+	p_proc->mutex_abiertos = &p_proc->mutex_propios;
+
+	// Round Robin: la rodaja y su modo se heredan del creador
+	if (p_proc_actual != NULL){
+		p_proc->rodaja = p_proc_actual->rodaja;
+		p_proc->rodaja_adaptativa = p_proc_actual->rodaja_adaptativa;
+	}
+	else {
+		p_proc->rodaja = TICKS_POR_RODAJA;
+		p_proc->rodaja_adaptativa = 0;
+	}
+	p_proc->vida = p_proc->rodaja;
+	p_proc->rodajas_agotadas = 0;
+	p_proc->bloqueos_tempranos = 0;
+
+	// CFS: el valor nice se hereda y empieza con el vruntime minimo
+	p_proc->nice = (p_proc_actual != NULL) ? p_proc_actual->nice : 0;
+	p_proc->peso = pesos_nice[p_proc->nice - NICE_MINIMO];
+	p_proc->vruntime = min_vruntime;
+
+	// Stride: los tickets se heredan y empieza con el paso minimo
+	p_proc->tickets = (p_proc_actual != NULL) ? p_proc_actual->tickets : TICKETS_POR_DEFECTO;
+	p_proc->zancada = ZANCADA_BASE / p_proc->tickets;
+	p_proc->paso = paso_global;
+
+	// Tiempo real: no se hereda
+	p_proc->tiempo_real = 0;
+	p_proc->plazos_incumplidos = 0;
+	p_proc->excesos_presupuesto = 0;
+
+	// Estadisticas
+	memset(&p_proc->estadisticas, 0, sizeof(p_proc->estadisticas));
+
+	// Prioridad: en MLFQ empieza en el nivel maximo, si no se hereda del creador
+	// (sin la que este haya heredado por mutex)
+	if (politica_planif == PLANIF_MLFQ)
+		p_proc->prioridad = NUM_PRIORIDADES-1;
+	else if (p_proc_actual != NULL)
+		p_proc->prioridad = p_proc_actual->prioridad_base;
+	else
+		p_proc->prioridad = PRIORIDAD_POR_DEFECTO;
+	p_proc->prioridad_base = p_proc->prioridad;
+	p_proc->mutex_esperado = NULL;
+}
+
+/*
+ *
+ * Funcion auxiliar que pone en marcha un proceso nuevo insertandolo al
+ * final de cola de listos de su prioridad. Se llama con las
+ * interrupciones inhibidas.
+ *
+ */
+static void activar_proceso(BCP *p_proc){
+	insertar_listo(p_proc);
+	anotar_listo(p_proc);
+	num_procesos++;
+}
+
+/*
+ *
+ * Funcion auxiliar que devuelve a la lista de libres una entrada
+ * reservada que no se ha llegado a usar
+ *
+ */
+static void devolver_BCP_libre(BCP *p_proc){
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	insertar_primero(&BCPs_libres, p_proc);
+	if (espera_BCP_libre.primero != NULL)
+		desbloquear_proceso(&espera_BCP_libre, espera_BCP_libre.primero);
+	fijar_nivel_int(nivel_interrupcion_previo);
+}
+
+/*
+ *
+ * Funcion auxiliar de las llamadas que crean un proceso esperando a que
+ * haya una entrada libre en la tabla de procesos. Espera como mucho ticks
+ * ticks (sin limite si es negativo y sin esperar si es 0). Devuelve 0 si
+ * hay una entrada libre o un numero negativo si no.
+ *
+ */
+static int esperar_BCP_libre(int ticks){
+	int limite = 0;
+
+	if (ticks > 0){
+		// En un periodo largo del reloj sin ticks se pone al dia num_int_reloj
+		ajustar_reloj();
+		limite = num_int_reloj + ticks;
+	}
+	while (BCPs_libres.primero == NULL){
+		if (ticks == 0)
+			return ERROR_GENERICO;
+		if (ticks > 0 && limite <= num_int_reloj){
+			printk("--> PROC %d: VENCE EL PLAZO DE ESPERA DE ENTRADA LIBRE\n", p_proc_actual->id);
+			return ERROR_PLAZO_CREAR;
+		}
+		printk("--> PROC %d: TABLA DE PROCESOS LLENA. ESPERA\n", p_proc_actual->id);
+		if (ticks < 0)
+			bloquear_proceso(&espera_BCP_libre);
+		else
+			esperar_plazo(&espera_BCP_libre, limite - num_int_reloj);
+	}
+	return 0;
+}
+
+/*
+ *
+ * Funcion auxiliar que crea un proceso reservando sus recursos.
+ * Usada por llamada crear_proceso.
+ *
+ */
+static int crear_tarea(char *prog){
+	void * imagen, *pc_inicial;
+	int proc;
+	BCP *p_proc;
+
+	proc=buscar_BCP_libre();
+	if (proc==-1)
+		return -1;	/* no hay entrada libre */
+	p_proc=&(tabla_procs[proc]);
+
+	/* crea la imagen de memoria leyendo ejecutable */
+	imagen=obtener_imagen(prog, &pc_inicial);
+	if (imagen == NULL){
+		devolver_BCP_libre(p_proc); /* no se ha llegado a usar */
+		return -1; /* fallo al crear imagen */
+	}
 
 	/* A rellenar el BCP ... */
+	iniciar_BCP(p_proc, imagen, pc_inicial);
+
+	/* lo inserta al final de cola de listos de su prioridad */
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	ajustar_reloj();
+	activar_proceso(p_proc);
+	reprogramar_reloj();
+	fijar_nivel_int(nivel_interrupcion_previo);
+	return 0;
+}
+
+/*
+ *
+ * Rutinas que llevan a cabo las llamadas al sistema
+ *	sis_crear_proceso sis_escribir
+ *
+ */
+
+/*
+ * Tratamiento de llamada al sistema crear_proceso. Llama a la
+ * funcion auxiliar crear_tarea sis_terminar_proceso
+ */
+int sis_crear_proceso(){
+	char *prog;
+	int res;
+
+	printk("-> PROC %d: CREAR PROCESO\n", p_proc_actual->id);
+	prog=(char *)leer_registro(1);
+	res=crear_tarea(prog);
+	return res;
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_proceso_bloq. Como
+ * crear_proceso, pero si la tabla de procesos esta llena espera a que
+ * termine algun proceso.
+ */
+int crear_proceso_bloq(){
+	char *prog = (char *) leer_registro(1);
+	int res;
+
+	printk("-> PROC %d: CREAR PROCESO (BLOQUEANTE)\n", p_proc_actual->id);
+	if ((res = esperar_BCP_libre(-1)) < 0)
+		return res;
+	return crear_tarea(prog);
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_proceso_timeout. Como
+ * crear_proceso_bloq, pero espera como mucho el numero de milisegundos
+ * indicado (redondeado hacia arriba a ticks). Si vence el plazo devuelve
+ * ERROR_PLAZO_CREAR. Con 0 milisegundos equivale a crear_proceso.
+ */
+int crear_proceso_timeout(){
+	char *prog = (char *) leer_registro(1);
+	unsigned int milisegs = (unsigned int) leer_registro(2);
+	int res;
+
+	printk("-> PROC %d: CREAR PROCESO (PLAZO %d MS)\n", p_proc_actual->id, milisegs);
+	if ((res = esperar_BCP_libre(ms_a_ticks(milisegs))) < 0)
+		return res;
+	return crear_tarea(prog);
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_procesos. Crea n procesos del
+ * mismo programa reservando de una vez sus entradas de la tabla, cargando
+ * la imagen una sola vez, que comparten con un contador comun como los
+ * hilos, e insertandolos en la cola de listos con una unica inhibicion de
+ * las interrupciones. Crea todos o ninguno. Si pids no es nulo guarda en
+ * el sus identificadores (-1 en todos si no crea ninguno). Devuelve n o
+ * un numero negativo si no hay entradas libres suficientes o no se puede
+ * cargar el programa.
+ */
+int crear_procesos(){
+	char *prog = (char *) leer_registro(1);
+	int n = (int) leer_registro(2);
+	int *pids = (int *) leer_registro(3);
+	lista_BCPs creados = {NULL, NULL};
+	void *imagen, *pc_inicial;
+	int *procesos_imagen = NULL;
+	BCP *p_proc;
+	int i;
+
+	printk("-> PROC %d: CREAR %d PROCESOS %s\n", p_proc_actual->id, n, prog);
+	if (n <= 0)
+		return ERROR_GENERICO;
+
+	// Antes de reservar nada, por si el puntero no es valido, se marcan
+	// los identificadores como no creados
+	zona_mem_proc_usuario = 1;
+	for (i = 0; pids != NULL && i < n; i++)
+		pids[i] = -1;
+	zona_mem_proc_usuario = 0;
+
+	// Comprueba que hay n entradas libres
+	for (i = 0, p_proc = BCPs_libres.primero; i < n && p_proc != NULL;
+	     i++, p_proc = p_proc->siguiente)
+		;
+	if (i < n){
+		printk("--->ERROR: No hay %d entradas libres en la tabla de procesos\n", n);
+		return ERROR_GENERICO;
+	}
+
+	imagen = obtener_imagen(prog, &pc_inicial);
+	if (imagen == NULL)
+		return ERROR_GENERICO;
+	if (n > 1 && (procesos_imagen = malloc(sizeof(int))) == NULL){
+		soltar_imagen(imagen);
+		return ERROR_GENERICO;
+	}
+
+	// Reserva las entradas y rellena los BCPs, que comparten la imagen
+	for (i = 0; i < n; i++){
+		p_proc = BCPs_libres.primero;
+		eliminar_primero(&BCPs_libres);
+		iniciar_BCP(p_proc, imagen, pc_inicial);
+		p_proc->hilos_imagen = procesos_imagen;
+		insertar_ultimo(&creados, p_proc);
+	}
+	if (procesos_imagen != NULL)
+		*procesos_imagen = n;
+
+	zona_mem_proc_usuario = 1;
+	for (i = 0, p_proc = creados.primero; pids != NULL && i < n; i++, p_proc = p_proc->siguiente)
+		pids[i] = p_proc->id;
+	zona_mem_proc_usuario = 0;
+
+	// Los pone en marcha a todos a la vez
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	ajustar_reloj();
+	while ((p_proc = creados.primero) != NULL){
+		eliminar_primero(&creados);
+		activar_proceso(p_proc);
+	}
+	reprogramar_reloj();
+	fijar_nivel_int(nivel_interrupcion_previo);
+	return n;
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_hilo. Crea un proceso que
+ * comparte la imagen del que la invoca pero tiene su propia pila y
+ * contexto, que arranca en la funcion lanzadera de la biblioteca; esta
+ * obtiene con datos_hilo la funcion y el argumento del hilo. Tambien
+ * comparten la tabla de mutex abiertos, con un contador comun como la
+ * imagen: lo que abre o cierra uno lo ven todos, y solo el ultimo en
+ * terminar los cierra. Quien tiene cada mutex y las lecturas de cada
+ * rwlock siguen siendo de cada hilo.
+ * Devuelve el identificador del hilo, al que se puede esperar con
+ * esperar_proceso, o un numero negativo en caso de error.
+ */
+int crear_hilo(){
+	void *lanzadera = (void *) leer_registro(1);
+	void *funcion = (void *) leer_registro(2);
+	void *arg = (void *) leer_registro(3);
+	int proc;
+	BCP *p_proc;
+
+	printk("-> PROC %d: CREAR HILO\n", p_proc_actual->id);
+	if (lanzadera == NULL || funcion == NULL)
+		return ERROR_GENERICO;
+	proc=buscar_BCP_libre();
+	if (proc==-1)
+		return ERROR_GENERICO;	/* no hay entrada libre */
 	p_proc=&(tabla_procs[proc]);
 
-	/* crea la imagen de memoria leyendo ejecutable */
-	imagen=crear_imagen(prog, &pc_inicial);
-	if (imagen)	{	
-		p_proc->info_mem=imagen;
-		p_proc->pila=crear_pila(TAM_PILA);
-		fijar_contexto_ini(p_proc->info_mem, p_proc->pila, TAM_PILA, pc_inicial, &(p_proc->contexto_regs));
-		p_proc->id=proc;
-		p_proc->estado=LISTO;
-		
-		// Dormir
-		p_proc->dormir = 0;
+	// La tabla de mutex abiertos pasa a ser comun a todos sus hilos
+	if (p_proc_actual->mutex_abiertos == &p_proc_actual->mutex_propios){
+		descriptores_mutex *tabla = malloc(sizeof(descriptores_mutex));
+		if (tabla == NULL){
+			devolver_BCP_libre(p_proc);
+			return ERROR_GENERICO;
+		}
+		*tabla = p_proc_actual->mutex_propios;
+		p_proc_actual->mutex_abiertos = tabla;
+	}
+
+	// Todos los hilos que comparten la imagen usan un mismo contador
+	if (p_proc_actual->hilos_imagen == NULL){
+		if ((p_proc_actual->hilos_imagen = malloc(sizeof(int))) == NULL){
+			devolver_BCP_libre(p_proc);
+			return ERROR_GENERICO;
+		}
+		*p_proc_actual->hilos_imagen = 1;
+	}
+	(*p_proc_actual->hilos_imagen)++;
+
+	iniciar_BCP(p_proc, p_proc_actual->info_mem, lanzadera);
+	p_proc->hilos_imagen = p_proc_actual->hilos_imagen;
+	p_proc->funcion_hilo = funcion;
+	p_proc->arg_hilo = arg;
+
+	// Comparte la tabla de mutex abiertos; cada uno tiene sus lecturas
+	p_proc->mutex_abiertos = p_proc_actual->mutex_abiertos;
+	p_proc->mutex_abiertos->n_hilos++;
+
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	ajustar_reloj();
+	activar_proceso(p_proc);
+	reprogramar_reloj();
+	fijar_nivel_int(nivel_interrupcion_previo);
+	return p_proc->id;
+}
+
+/*
+ * Tratamiento de llamada al sistema datos_hilo, usada por la lanzadera de
+ * hilos de la biblioteca para obtener la funcion y el argumento del hilo.
+ * Devuelve 0 o un numero negativo si el que la invoca no es un hilo.
+ */
+int datos_hilo(){
+	void **funcion = (void **) leer_registro(1);
+	void **arg = (void **) leer_registro(2);
+
+	if (p_proc_actual->funcion_hilo == NULL || funcion == NULL || arg == NULL)
+		return ERROR_GENERICO;
+	// Flag para saber que estamos en zona de memoria de proceso usuario
+	zona_mem_proc_usuario = 1;
+	*funcion = p_proc_actual->funcion_hilo;
+	*arg = p_proc_actual->arg_hilo;
+	zona_mem_proc_usuario = 0;
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema ejecutar. Sustituye la imagen del
+ * proceso que la invoca por la del programa indicado y lo pone a ejecutar
+ * desde su inicio sobre la misma pila, conservando el BCP: identificador,
+ * tiempos, mutex abiertos, hijos y parametros de planificacion. Si lo
+ * invoca un hilo, deja de compartir la imagen con los demas. Solo vuelve
+ * si no se puede cargar el programa, devolviendo un numero negativo.
+ */
+int ejecutar(){
+	char *prog = (char *) leer_registro(1);
+	void *imagen, *pc_inicial;
+
+	printk("-> PROC %d: EJECUTAR %s\n", p_proc_actual->id, prog);
+	imagen = obtener_imagen(prog, &pc_inicial);
+	if (imagen == NULL)
+		return ERROR_GENERICO;
+
+	soltar_imagen_proceso(p_proc_actual);
+	p_proc_actual->info_mem = imagen;
+	p_proc_actual->funcion_hilo = NULL;
+
+	// El contexto inicial se construye en la cima de la pila, ocupada
+	// solo por los marcos de la imagen anterior, que ya no se usan
+	fijar_contexto_ini(imagen, p_proc_actual->pila, p_proc_actual->tam_pila,
+		pc_inicial, &(p_proc_actual->contexto_regs));
+	cambio_contexto(NULL, &(p_proc_actual->contexto_regs));
+	return 0; /* no debera llegar aqui */
+}
+
+/*
+ * Tratamiento de llamada al sistema escribir. Llama simplemente a la
+ * funcion de apoyo escribir_ker
+ */
+int sis_escribir(){
+	char *texto;
+	unsigned int longi;
+
+	texto=(char *)leer_registro(1);
+	longi=(unsigned int)leer_registro(2);
+
+	escribir_ker(texto, longi);
+	return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema terminar_proceso. Llama a la
+ * funcion auxiliar liberar_proceso con el valor de terminacion
+ */
+int sis_terminar_proceso(){
+	int estado = (int) leer_registro(1);
+
+	printk("-> FIN PROCESO %d (ESTADO %d)\n", p_proc_actual->id, estado);
+	liberar_proceso(estado);
+    return 0; /* no debera llegar aqui */
+}
+
+/*
+ * Tratamiento de llamada al sistema esperar_proceso. Espera a que termine
+ * el hijo indicado o, si pid es -1, cualquiera de ellos, y lo libera.
+ * Si estado no es nulo guarda en el su valor de terminacion. Devuelve el
+ * identificador del hijo o un numero negativo si no es hijo suyo (o no
+ * tiene hijos que esperar).
+ */
+int esperar_proceso(){
+	int pid = (int) leer_registro(1);
+	int *estado = (int *) leer_registro(2);
+	BCP *hijo = NULL;
+
+	printk("-> PROC %d: ESPERAR PROCESO %d\n", p_proc_actual->id, pid);
+	if (pid != -1 && ((hijo = buscar_proceso(pid)) == NULL || hijo->padre != p_proc_actual))
+		return ERROR_NO_HIJO;
+	if (pid == -1 && p_proc_actual->num_hijos == 0)
+		return ERROR_NO_HIJO;
+
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	if (pid == -1)
+		while ((hijo = p_proc_actual->hijos_terminados.primero) == NULL)
+			bloquear_proceso(&p_proc_actual->espera_hijos);
+	else
+		while (hijo->estado != ZOMBI)
+			bloquear_proceso(&p_proc_actual->espera_hijos);
+	fijar_nivel_int(nivel_interrupcion_previo);
+
+	if (estado != NULL){
+		// Flag para saber que estamos en zona de memoria de proceso usuario
+		zona_mem_proc_usuario = 1;
+		*estado = hijo->estado_fin;
+		zona_mem_proc_usuario = 0;
+	}
+
+	nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	pid = hijo->id;
+	eliminar_elem(&p_proc_actual->hijos_terminados, hijo);
+	quitar_hijo(hijo);
+	liberar_entrada(hijo);
+	fijar_nivel_int(nivel_interrupcion_previo);
+	printk("--> PROC %d: RECOGE AL PROCESO %d\n", p_proc_actual->id, pid);
+	return pid;
+}
+//-----------------------------------------------------------------------------------------
+
+/**
+* Funcion que retorna el id del proceso que la invoca
+*/
+int obtener_id_pr(){
+	return p_proc_actual->id;
+}
+
+/**
+* Llamada que permita que un proceso pueda qudarse bloqueado un plazo de tiempo
+*/
+int dormir(){
+	unsigned int segundos = (unsigned int) leer_registro(1);
+	//printk("-> PROC %d: DORMIR %d SEGUNDOS\n", p_proc_actual->id, segundos);
+
+	// Los procesos duerment el numero de ticks apropiados
+	esperar_plazo(NULL, segundos*TICK);
+
+	return 0;
+}
+
+/**
+* Llamada que bloquea al proceso durante un numero de milisegundos.
+* El plazo se redondea hacia arriba a un numero entero de ticks (con
+* TICK=100, multiplos de 10 ms) y se mide como en dormir, por lo que la
+* espera real puede ser hasta un tick menor. Con 0 ms retorna sin bloquear.
+*/
+int dormir_ms(){
+	unsigned int milisegs = (unsigned int) leer_registro(1);
+	int ticks = ms_a_ticks(milisegs);
+
+	if (ticks == 0)
+		return 0;
+	esperar_plazo(NULL, ticks);
+	return 0;
+}
+
+/**
+* Llamada que bloquea al proceso hasta que el numero de interrupciones de
+* reloj (el valor que devuelve tiempos_proceso) llegue al tick indicado.
+* Al ser un plazo absoluto, un bucle periodico que sume su periodo al tick
+* anterior no acumula deriva. Si el tick ya ha pasado retorna sin bloquear.
+* Devuelve el numero de interrupciones de reloj al despertar.
+*/
+int dormir_hasta(){
+	int tick = (int) leer_registro(1);
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+
+	// En un periodo largo del reloj sin ticks se pone al dia num_int_reloj
+	ajustar_reloj();
+	if (tick > num_int_reloj)
+		esperar_plazo(NULL, tick - num_int_reloj);
+	fijar_nivel_int(nivel_interrupcion_previo);
+	return num_int_reloj;
+}
+
+/*
+ * Avanza la rueda de plazos hasta el tick actual despertando a los procesos
+ * cuyo plazo ha vencido. Tras un periodo largo del reloj sin ticks se
+ * tratan de golpe todos los ticks pendientes.
+ */
+void tratamiento_int_dormir(){
+	//printk("-> TRATANDO INT. DE RELOJ PARA PROCESOS DORMIDOS\n");
+	int indice, nivel;
+	BCP *p_proc, *siguiente;
+
+	while (tick_rueda <= num_int_reloj){
+		indice = tick_rueda & (TAM_RUEDA-1);
+		// Al completar una vuelta el nivel 0, baja la cubeta siguiente de los superiores
+		if (indice == 0)
+			for (nivel = 1; nivel < NIVELES_RUEDA && cascada_rueda(nivel) == 0; nivel++);
+
+		p_proc = rueda_plazos[0][indice];
+		rueda_plazos[0][indice] = NULL;
+		tick_rueda++;
+		for ( ; p_proc != NULL; p_proc = siguiente){
+			siguiente = p_proc->sig_plazo;
+			p_proc->ant_plazo = NULL;
+			num_plazos--;
+			// Si ademas esperaba un evento (lock o leer_caracter con plazo), sale de esa lista
+			desbloquear_proceso(p_proc->lista_espera, p_proc);
+		}
+	}
+}
+
+/**
+* Llamada que devuelve el numero de interrupciones que se han producio desde que arrancó el sistema. 
+* Si recibe un puntero no nulo, devuelve cuantas veces en la interrupcion de reloj se ha detectado que el proceso estaba ejecutado en modo usuario (campo usuario) y cuantas en modo sistema (campo sistema).
+* Si no hay proceso listo, estará ejecutando el último que se bloqueó. En este caso, no hay que imputarle tiempo de ejecución.
+*/
+int tiempos_proceso(){
+	//printk("-> PROC %d: TIEMPOS PROCESO\n", p_proc_actual->id);
+	struct tiempos_ejec *t_ejec = (struct tiempos_ejec *) leer_registro(1);
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	// En un periodo largo del reloj sin ticks se ponen al dia los contadores
+	ajustar_reloj();
+	if(t_ejec != NULL){
+		// Flag para saber que estamos en zona de memoria de proceso usuario
+		zona_mem_proc_usuario = 1;
+		t_ejec->usuario = p_proc_actual->tiempo_usuario;
+		t_ejec->sistema = p_proc_actual->tiempo_sistema;
+		zona_mem_proc_usuario = 0;
+	}
+	fijar_nivel_int(nivel_interrupcion_previo);
+	return num_int_reloj;
+}
+void tratamiento_uso_procesador(int ticks){
+	//printk("-> SUMANDO TICKS AL PROCESO\n");
+	BCPptr p_proc = primer_listo();
+	if(p_proc != NULL){
+		if(viene_de_modo_usuario()){
+			p_proc_actual->tiempo_usuario += ticks;
+		}else{
+			p_proc_actual->tiempo_sistema += ticks;
+		}
+	}
+}
+
+/*
+*	Funcion auxiliar de crear_mutex, crear_rwlock y crear_sem, que
+*	comparten la tabla de mutex, sus nombres y los descriptores de los
+*	procesos.
+*/
+static int crear_con_nombre(char *nombre, int tipo, int clase){
+	// Comprobar que el nombre no sea demasiado largo
+	if(len(nombre) > MAX_NOM_MUT){
+		printk("--->ERROR: El nombre del mutex es demasiado largo\n");
+		return ERROR_LONGITUD_NOMBRE;
+	}
+
+	// Comprobar que proceso no tiene mas de NUM_MUT_PROC
+	if(p_proc_actual->mutex_abiertos->num_mutex >= NUM_MUT_PROC){
+		printk("--->ERROR: El proceso %d tiene demasiados mutex\n", p_proc_actual->id);
+		return ERROR_MAX_NUM_MUTEX_PROC;
+	}
+	printk("--> PROC %d: INTENTA CREAR MUTEX %s\n", p_proc_actual->id, nombre);
+	// Comprobar que no se ha alcanzado el maximo numero de mutex
+	while(num_mutex_global >= num_mutex_max){
+		printk("--->ERROR: Creando %s. Se ha alcanzado el maximo numero de mutex, %d \n", nombre, num_mutex_global);
+		esperar_hueco_mutex(nombre);
+	}
+	// Volvemos a cogerlo por si nos bloqueamos para que se actualice el descriptor
+	int descriptor_mutex = buscar_mutex_libre_y_no_repetido(nombre);
+	int error;
+	if ((error = cumple_requisitos(nombre, descriptor_mutex)) < 0){
+		return error;
+	}
+
+
+	// Crear mutex
+	Mutex *mutex;
+	mutex = tabla_mutex[descriptor_mutex];
+	mutex->palabra.tipo = tipo;
+	mutex->clase = clase;
+	mutex->estado = LIBRE;
+	cpy(mutex->nombre, nombre);
+	insertar_mutex_hash(descriptor_mutex);
+
+	// Asociar mutex al proceso
+	int pos_mutex_proc = obtener_mutex_proc();
+	p_proc_actual->mutex_abiertos->descriptores[pos_mutex_proc] = descriptor_mutex;
+
+	// Actualizar estados
+	mutex->n_proc_asociados++;
+	printk("----> ACTUALIZACION: MUTEX %s TIENE %d PROCESOS ASOCIADOS\n", mutex->nombre, mutex->n_proc_asociados);
+	p_proc_actual->mutex_abiertos->num_mutex++;
+	printk("----> ACTUALIZACION: PROC %d TIENE %d MUTEX ASOCIADOS\n", p_proc_actual->id, p_proc_actual->mutex_abiertos->num_mutex);
+	num_mutex_global++;
+	printk("----> ACTUALIZACION: MUTEX EN SISTEMA %d\n", num_mutex_global);
+
+	printk("--> MUTEX %s con descriptor %d CREADO: TIENE %d ASOCIADOS \n", mutex->nombre, descriptor_mutex, mutex->n_proc_asociados);
+	printk("--> PROCESO TIENE %d mutex\n", p_proc_actual->mutex_abiertos->num_mutex);
+	printk("-> PROC %d: FIN CREAR MUTEX %d of %d\n", p_proc_actual->id, num_mutex_global, num_mutex_max);
+	// Devolver descriptor
+	return descriptor_mutex;
+}
+
+/**
+* Crear mutex con el nombre y tipo especificados.
+* Devuelve un entero que representa un descriptor para acceder al mutex. En caso de error devuelve un numero negativo.
+*/
+int crear_mutex(){
+	char *nombre = (char *) leer_registro(1);
+	int tipo = (int) leer_registro(2);
+	printk("-> PROC %d: CREAR MUTEX %s\n", p_proc_actual->id, nombre);
+	return crear_con_nombre(nombre, tipo, CLASE_MUTEX);
+}
+
+/**
+* Crear rwlock con el nombre y la preferencia especificados
+* (PREFERENCIA_LECTORES o PREFERENCIA_ESCRITORES). Comparte los
+* descriptores con los mutex. En caso de error devuelve un numero negativo.
+*/
+int crear_rwlock(){
+	char *nombre = (char *) leer_registro(1);
+	int preferencia = (int) leer_registro(2);
+	printk("-> PROC %d: CREAR RWLOCK %s\n", p_proc_actual->id, nombre);
+
+	if(preferencia != PREFERENCIA_LECTORES && preferencia != PREFERENCIA_ESCRITORES){
+		printk("--->ERROR: Preferencia %d de rwlock no valida\n", preferencia);
+		return ERROR_GENERICO;
+	}
+	int descriptor_mutex = crear_con_nombre(nombre, NO_RECURSIVO, CLASE_RWLOCK);
+	if(descriptor_mutex >= 0)
+		tabla_mutex[descriptor_mutex]->preferencia = preferencia;
+	return descriptor_mutex;
+}
+
+/**
+* Crear semaforo con el nombre y el valor inicial especificados. Comparte
+* los descriptores con los mutex. En caso de error devuelve un numero
+* negativo.
+*/
+int crear_sem(){
+	char *nombre = (char *) leer_registro(1);
+	int valor = (int) leer_registro(2);
+	printk("-> PROC %d: CREAR SEMAFORO %s CON VALOR %d\n", p_proc_actual->id, nombre, valor);
+
+	if(valor < 0){
+		printk("--->ERROR: Valor inicial %d de semaforo no valido\n", valor);
+		return ERROR_GENERICO;
+	}
+	int descriptor_mutex = crear_con_nombre(nombre, NO_RECURSIVO, CLASE_SEMAFORO);
+	if(descriptor_mutex >= 0)
+		tabla_mutex[descriptor_mutex]->valor = valor;
+	return descriptor_mutex;
+}
+
+/*
+*	Funcion auxiliar para comprobar las condiciones de creación de un mutex
+*/
+int cumple_requisitos(char *nombre, int descriptor_mutex){
+	if(descriptor_mutex == ERROR_MAX_NUM_MUTEX){
+		printk("--->ERROR: Se ha alcanzado el maximo numero de mutex\n");
+		return ERROR_MAX_NUM_MUTEX;
+	}
+	// Comprobar que no existe un mutex con ese nombre
+	if(descriptor_mutex == ERROR_NOMBRE_REPETIDO){
+		printk("--->ERROR: Ya existe un mutex con ese nombre\n");
+		return ERROR_NOMBRE_REPETIDO;
+	}
+	printk("--> COMPROBAMOS REQUISITIOS Y OBTENEMOS %d\n", descriptor_mutex);
+	return descriptor_mutex;
+}
+
+/**
+* 	Funcion auxiliar para esperar hasta que haya hueco en la tabla de mutex
+*/
+void esperar_hueco_mutex(char* nombre){
+	printk("--> PROC %d: ESPERANDO HUECO MUTEX %s\n", p_proc_actual->id, nombre);
+	printk("--> PROC %d: INSERTADO EN COLA DE ESPERA DE MUTEX\n", p_proc_actual->id);
+	bloquear_proceso(&lista_bloq_mutex);
+}
+
+/*
+*	Funcion auxiliar de abrir_mutex, abrir_rwlock y abrir_sem
+*/
+static int abrir_por_nombre(char *nombre, int clase){
+	
+	// Comprobar que proceso no tiene mas de NUM_MUT_PROC
+	if(p_proc_actual->mutex_abiertos->num_mutex >= NUM_MUT_PROC){
+		printk("-->ERROR: No tiene hueco para abrir el mutex %s\n", nombre);
+		return ERROR_MAX_NUM_MUTEX_PROC;
+	}
+	// Comprobar que el mutex existe en la tabla de mutex
+	int descriptor_mutex = buscar_mutex(nombre);
+	printk("---> TRABAJAMOS CON EL DESCRIPTOR %d del MUTEX %s\n", descriptor_mutex, nombre);
+	if(descriptor_mutex < 0){
+		printk("--->ERROR: El mutex %s no existe\n", nombre);
+		return ERROR_MUTEX_NO_EXISTE;
+	}
+	if(tabla_mutex[descriptor_mutex]->clase != clase){
+		printk("--->ERROR: %s no es del tipo que se quiere abrir\n", nombre);
+		return ERROR_TIPO_MUTEX;
+	}
+
+	if(!esta_mutex_asociado_a_proc(descriptor_mutex)){
+		// Asociar mutex a proceso
+		int index_mutex_proc = obtener_mutex_proc();
+		p_proc_actual->mutex_abiertos->descriptores[index_mutex_proc] = descriptor_mutex;
+
+		Mutex *mutex = tabla_mutex[descriptor_mutex];
+
+		// Actualizacion de estados
+		p_proc_actual->mutex_abiertos->num_mutex++;
+		printk("----> ACTUALIZACION: PROC %d TIENE %d MUTEX ASOCIADOS\n", p_proc_actual->id, p_proc_actual->mutex_abiertos->num_mutex);
+		mutex->n_proc_asociados++;
+		printk("----> ACTUALIZACION: MUTEX %s TIENE %d PROCESOS ASOCIADOS\n", mutex->nombre, mutex->n_proc_asociados);
+		printk("--> MUTEX %s con descriptor %d ABIERTO: TIENE %d PROCESOS ASOCIADOS \n", nombre, descriptor_mutex, mutex->n_proc_asociados);
+	}
+
+	printk("--> PROCESO TIENE %d mutex\n", p_proc_actual->mutex_abiertos->num_mutex);
+	printk("-> PROC %d: FIN ABRIR MUTEX %s. PROCESO TIENE ASOCIADOS %d MUTEXES Y DEVOLVEMOS DESCRIPTOR %d\n", p_proc_actual->id, nombre, p_proc_actual->mutex_abiertos->num_mutex, descriptor_mutex);
+
+	return descriptor_mutex;
+}
+
+/**
+*	Devuelve un descriptor asociado a un mutex ya existente o un número negativo en caso de error
+*/
+int abrir_mutex(){
+	char *nombre = (char *) leer_registro(1);
+	printk("-> PROC %d: ABRIR MUTEX %s Nº %d\n", p_proc_actual->id, nombre, p_proc_actual->mutex_abiertos->num_mutex);
+	return abrir_por_nombre(nombre, CLASE_MUTEX);
+}
+
+/**
+*	Devuelve un descriptor asociado a un rwlock ya existente o un número negativo en caso de error
+*/
+int abrir_rwlock(){
+	char *nombre = (char *) leer_registro(1);
+	printk("-> PROC %d: ABRIR RWLOCK %s\n", p_proc_actual->id, nombre);
+	return abrir_por_nombre(nombre, CLASE_RWLOCK);
+}
+
+/**
+*	Devuelve un descriptor asociado a un semaforo ya existente o un número negativo en caso de error
+*/
+int abrir_sem(){
+	char *nombre = (char *) leer_registro(1);
+	printk("-> PROC %d: ABRIR SEMAFORO %s\n", p_proc_actual->id, nombre);
+	return abrir_por_nombre(nombre, CLASE_SEMAFORO);
+}
+
+/*
+* 	Funcion auxiliar para ver si el mutex está asociado
+* 	Devuelve 1 si lo encuentra || 0 si no lo encuentra
+*/
+int esta_mutex_asociado_a_proc(int des){
+	int encontrado = 0;
+	int i = 0;
+	while(!encontrado && i < NUM_MUT_PROC){
+		if(p_proc_actual->mutex_abiertos->descriptores[i] == des){
+			encontrado = 1;
+		}
+		i++;
+	}
+	return encontrado;
+}
+
+/*
+ * Despierta a los que pueden obtener un rwlock que ha quedado libre de
+ * escritor: a un escritor si no quedan lectores y la preferencia es de
+ * escritores o no esperan lectores, y si no a todos los lectores salvo
+ * que con preferencia de escritores espere alguno. Los despertados
+ * vuelven a comprobar si pueden obtenerlo.
+ */
+static void despertar_rwlock(Mutex *rw){
+	BCPptr escritor = rw->procesos_bloqueados.primero;
+
+	if(rw->palabra.cerrojo != CERROJO_LIBRE)
+		return;
+	if(escritor != NULL && rw->n_lectores == 0 &&
+			(rw->preferencia == PREFERENCIA_ESCRITORES || rw->lectores_bloqueados.primero == NULL)){
+		printk("----> DESPIERTA a escritor %d del RWLOCK %s\n", escritor->id, rw->nombre);
+		desbloquear_proceso(&rw->procesos_bloqueados, escritor);
+		return;
+	}
+	if(escritor != NULL && rw->preferencia == PREFERENCIA_ESCRITORES)
+		return;
+	while(rw->lectores_bloqueados.primero != NULL){
+		printk("----> DESPIERTA a lector %d del RWLOCK %s\n", rw->lectores_bloqueados.primero->id, rw->nombre);
+		desbloquear_proceso(&rw->lectores_bloqueados, rw->lectores_bloqueados.primero);
+	}
+}
+
+/*
+ * Libera lo que tiene el proceso actual del rwlock que ocupa la posicion
+ * index_mutex_proc de sus descriptores: la escritura o una lectura (todas
+ * si todo es 1, al cerrarlo)
+ */
+static void soltar_rwlock(Mutex *rw, int index_mutex_proc, int todo){
+	int *lecturas = &p_proc_actual->lecturas_rwlock[index_mutex_proc];
+
+	if(PROPIETARIO(rw->palabra.cerrojo) == p_proc_actual->id){
+		printk("----> PROC %d: SUELTA ESCRITURA del RWLOCK %s\n", p_proc_actual->id, rw->nombre);
+		rw->palabra.cerrojo = CERROJO_LIBRE;
+		rw->palabra.n_veces = 0;
+	}
+	else if(*lecturas > 0){
+		int n = todo ? *lecturas : 1;
+		*lecturas -= n;
+		p_proc_actual->mutex_abiertos->lecturas[index_mutex_proc] -= n;
+		rw->n_lectores -= n;
+		printk("----> PROC %d: SUELTA %d LECTURAS del RWLOCK %s. QUEDAN %d\n", p_proc_actual->id, n, rw->nombre, rw->n_lectores);
+	}
+	else
+		return;
+	despertar_rwlock(rw);
+}
+
+/*
+ * Libera lo que tiene el proceso actual del mutex, rwlock o semaforo que
+ * ocupa la posicion index_mutex_proc de sus descriptores, al cerrarlo o
+ * al terminar un hilo que comparte la tabla con otros
+ */
+void soltar_lo_propio(unsigned int mutexid, int index_mutex_proc){
+	Mutex *mutex = tabla_mutex[mutexid];
+
+	if(mutex->clase == CLASE_RWLOCK)
+		soltar_rwlock(mutex, index_mutex_proc, 1);
+	else if(mutex->clase == CLASE_MUTEX && PROPIETARIO(mutex->palabra.cerrojo) == p_proc_actual->id){
+		printk("----> PROC %d: UNLOCK IMPLICITO\n", p_proc_actual->id);
+		mutex->palabra.n_veces = 1; // Para que desbloque todos los procesos
+		escribir_registro(1,mutexid);
+		unlock();
+	}
+}
+
+/*
+ * Devuelve 1 si otro hilo que comparte la tabla de mutex abiertos del
+ * proceso actual tiene el de la posicion index_mutex_proc (para escritura
+ * o lectura si es un rwlock) o esta esperando en el
+ */
+static int usado_por_otro_hilo(Mutex *mutex, int index_mutex_proc){
+	descriptores_mutex *tabla = p_proc_actual->mutex_abiertos;
+	BCPptr p_proc;
+
+	if(tabla->n_hilos <= 1)
+		return 0;
+	p_proc = buscar_proceso(PROPIETARIO(mutex->palabra.cerrojo));
+	if(p_proc != NULL && p_proc != p_proc_actual && p_proc->mutex_abiertos == tabla)
+		return 1;
+	if(tabla->lecturas[index_mutex_proc] > p_proc_actual->lecturas_rwlock[index_mutex_proc])
+		return 1;
+	for(p_proc = mutex->procesos_bloqueados.primero; p_proc != NULL; p_proc = p_proc->siguiente)
+		if(p_proc->mutex_abiertos == tabla)
+			return 1;
+	for(p_proc = mutex->lectores_bloqueados.primero; p_proc != NULL; p_proc = p_proc->siguiente)
+		if(p_proc->mutex_abiertos == tabla)
+			return 1;
+	return 0;
+}
+
+/**
+* 	 Cierra el mutex especificado, devolviendo un número negativo en caso de error.
+*/
+int cerrar_mutex(){
+	unsigned int mutexid = (unsigned int) leer_registro(1);
+	int index_mutex_proc = buscar_descriptor_mutex_proc(mutexid);
+
+	if(index_mutex_proc < 0){
+		printk("--->ERROR: El proceso %d no tiene el mutex %d\n", p_proc_actual->id, mutexid);
+		return ERROR_MUTEX_NO_EXISTE;
+	}
+
+	Mutex *mutex = tabla_mutex[mutexid];
+	printk("-> PROC %d: CERRAR MUTEX %s\n", p_proc_actual->id, mutex->nombre);
+	printk("---> TRABAJAMOS CON EL DESCRIPTOR %d del MUTEX %s\n", mutexid, mutex->nombre);
+
+	// El descriptor es comun a sus hilos: no se cierra mientras otro lo use
+	if(usado_por_otro_hilo(mutex, index_mutex_proc)){
+		printk("--->ERROR: Otro hilo del proceso %d usa el mutex %s\n", p_proc_actual->id, mutex->nombre);
+		return ERROR_MUTEX_OCUPADO;
+	}
+
+	// Desasociar proceso al mutex
+	mutex->n_proc_asociados--;
+	printk("----> ACTUALIZACION: MUTEX %s TIENE %d PROCESOS ASOCIADOS\n", mutex->nombre, mutex->n_proc_asociados);
+	// Invalida las palabras que la biblioteca guarda de este mutex
+	mutex->palabra.generacion++;
+
+	// Si proceso tenia bloqueado mutex, desbloquear procesos
+	soltar_lo_propio(mutexid, index_mutex_proc);
+
+
+	// Si es el ultimo proceso en estar asociado, eliminamos mutex
+	if(mutex->n_proc_asociados == 0){
+		liberar_mutex(mutexid);
+		num_mutex_global--;
+		printk("----> ACTUALIZACION: MUTEX EN SISTEMA %d\n", num_mutex_global);
+
+	}
+
+	// Desasociar mutex al proceso
+	p_proc_actual->mutex_abiertos->descriptores[index_mutex_proc] = NO_USADO;
+	p_proc_actual->mutex_abiertos->num_mutex--;
+	printk("----> ACTUALIZACION: PROC %d TIENE %d MUTEX ASOCIADOS\n", p_proc_actual->id, p_proc_actual->mutex_abiertos->num_mutex);
+	
+	BCPptr p_proc = lista_bloq_mutex.primero;
+	if(p_proc != NULL){
+		// Desbloquear procesos bloqueados por el mutex
+		printk("---> DESBLOQUEANDO a proc %d por MUTEX %s con descriptor %d\n", p_proc->id, mutex->nombre, mutexid);
+		desbloquear_proceso(&lista_bloq_mutex, p_proc);
+	}
+	
+	printk("--> MUTEX %s con descriptor %d CERRADO: TIENE %d PROCESOS ASOCIADOS \n", mutex->nombre, mutexid, mutex->n_proc_asociados);
+	printk("--> PROCESO TIENE %d mutex\n", p_proc_actual->mutex_abiertos->num_mutex);
+	printk("-> PROC %d: FIN CERRAR MUTEX %s. PROCESO TIENE ASOCIADOS %d MUTEXES Y DEVOLVEMOS DESCRIPTOR %d\n", p_proc_actual->id, mutex->nombre, p_proc_actual->mutex_abiertos->num_mutex, mutexid);
+	
+	return 0;
+}
+
+/*
+ * Herencia de prioridad (solo con PLANIF_PRIORIDADES): el proceso que
+ * tiene un mutex ejecuta con la prioridad del mas prioritario de los que
+ * lo esperan si es mayor que la suya. Si a su vez esta bloqueado en otro
+ * mutex, la herencia se propaga por la cadena de propietarios. Al
+ * liberarlo vuelve a la que le corresponda por los demas que tenga.
+ */
 
-		// Tiempos proceso
-		p_proc->tiempo_usuario = 0;
-		p_proc->tiempo_sistema = 0;
+/*
+ * Devuelve la prioridad mas alta de los que esperan el mutex o -1
+ */
+static int prioridad_esperas(Mutex *mutex){
+	int prioridad = -1;
 
-		// Mutex
-		for(int i = 0; i < NUM_MUT_PROC; i++){
-			p_proc->descriptores_mutex[i] = NO_USADO;
-		}
-		p_proc->num_mutex = 0;
+	for (BCPptr p_proc = mutex->procesos_bloqueados.primero; p_proc != NULL; p_proc = p_proc->siguiente)
+		if (p_proc->prioridad > prioridad)
+			prioridad = p_proc->prioridad;
+	return prioridad;
+}
 
-		// Round Robin
-		p_proc->vida = TICKS_POR_RODAJA;
+/*
+ * Devuelve el que debe recibir el mutex: el primero en llegar de los mas
+ * prioritarios que lo esperan (el primero sin mas con otras politicas)
+ */
+static BCP * primer_esperando(Mutex *mutex){
+	BCPptr elegido = mutex->procesos_bloqueados.primero;
+
+	if (politica_planif != PLANIF_PRIORIDADES)
+		return elegido;
+	for (BCPptr p_proc = elegido; p_proc != NULL; p_proc = p_proc->siguiente)
+		if (p_proc->prioridad > elegido->prioridad)
+			elegido = p_proc;
+	return elegido;
+}
 
-		/* lo inserta al final de cola de listos */
-		int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-		insertar_ultimo(&lista_listos, p_proc);
-		error= 0;
-		fijar_nivel_int(nivel_interrupcion_previo);
+/*
+ * Devuelve la prioridad que corresponde a un proceso: la suya o la mas
+ * alta de los que esperan los mutex que tiene
+ */
+static int prioridad_efectiva(BCP *p_proc){
+	int prioridad = p_proc->prioridad_base;
+
+	if (politica_planif != PLANIF_PRIORIDADES)
+		return prioridad;
+	for (int i = 0; i < NUM_MUT_PROC; i++){
+		int des = p_proc->mutex_abiertos->descriptores[i];
+		if (des == NO_USADO || tabla_mutex[des]->clase != CLASE_MUTEX || PROPIETARIO(tabla_mutex[des]->palabra.cerrojo) != p_proc->id)
+			continue;
+		if (prioridad_esperas(tabla_mutex[des]) > prioridad)
+			prioridad = prioridad_esperas(tabla_mutex[des]);
 	}
-	else
-		error= -1; /* fallo al crear imagen */
-
-	return error;
+	return prioridad;
 }
 
 /*
- *
- * Rutinas que llevan a cabo las llamadas al sistema
- *	sis_crear_proceso sis_escribir
- *
+ * Cambia la prioridad de un proceso recolocandolo en las colas de listos
+ * y pide la expulsion del actual si deja de ser el mas prioritario
  */
+static void aplicar_prioridad(BCP *p_proc, int prioridad){
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+
+	if (p_proc->estado != LISTO)
+		p_proc->prioridad = prioridad;
+	else if (p_proc == p_proc_actual){
+		// El proceso sigue en ejecucion, por lo que pasa a la cabeza de su nuevo nivel
+		eliminar_listo(p_proc);
+		p_proc->prioridad = prioridad;
+		insertar_listo_primero(p_proc);
+		// Si al bajar la prioridad hay otro proceso mas prioritario, cede el procesador
+		if (primer_listo() != p_proc){
+			id_proc_a_expulsar = p_proc->id;
+			activar_int_SW();
+		}
+	}
+	else {
+		eliminar_listo(p_proc);
+		p_proc->prioridad = prioridad;
+		insertar_listo(p_proc);
+		comprobar_expulsion(p_proc);
+	}
+	fijar_nivel_int(nivel_interrupcion_previo);
+}
 
 /*
- * Tratamiento de llamada al sistema crear_proceso. Llama a la
- * funcion auxiliar crear_tarea sis_terminar_proceso
+ * Eleva a prioridad al propietario de un mutex que se va a esperar y, si
+ * este esta bloqueado en otro, a los siguientes de la cadena
  */
-int sis_crear_proceso(){
-	char *prog;
-	int res;
-
-	printk("-> PROC %d: CREAR PROCESO\n", p_proc_actual->id);
-	prog=(char *)leer_registro(1);
-	res=crear_tarea(prog);
-	return res;
+static void heredar_prioridad(BCP *p_proc, int prioridad){
+	if (politica_planif != PLANIF_PRIORIDADES)
+		return;
+	for (int n = 0; p_proc != NULL && p_proc->prioridad < prioridad && n < num_procs_max; n++){
+		printk("----> PROC %d: HEREDA PRIORIDAD %d (BASE %d)\n", p_proc->id, prioridad, p_proc->prioridad_base);
+		aplicar_prioridad(p_proc, prioridad);
+		if (p_proc->mutex_esperado == NULL)
+			return;
+		p_proc = buscar_proceso(PROPIETARIO(p_proc->mutex_esperado->palabra.cerrojo));
+	}
 }
 
 /*
- * Tratamiento de llamada al sistema escribir. Llama simplemente a la
- * funcion de apoyo escribir_ker
+ * Recalcula la prioridad de un proceso cuando cambian los que esperan sus
+ * mutex y, si cambia y esta bloqueado en otro, la de los siguientes de la
+ * cadena
  */
-int sis_escribir(){
-	char *texto;
-	unsigned int longi;
+static void actualizar_herencia(BCP *p_proc){
+	if (politica_planif != PLANIF_PRIORIDADES)
+		return;
+	for (int n = 0; p_proc != NULL && n < num_procs_max; n++){
+		int prioridad = prioridad_efectiva(p_proc);
+		if (prioridad == p_proc->prioridad)
+			return;
+		printk("----> PROC %d: PASA A PRIORIDAD %d (BASE %d)\n", p_proc->id, prioridad, p_proc->prioridad_base);
+		aplicar_prioridad(p_proc, prioridad);
+		if (p_proc->mutex_esperado == NULL)
+			return;
+		p_proc = buscar_proceso(PROPIETARIO(p_proc->mutex_esperado->palabra.cerrojo));
+	}
+}
 
-	texto=(char *)leer_registro(1);
-	longi=(unsigned int)leer_registro(2);
+/*
+*	Funcion auxiliar de lock, trylock y lock_timeout. Si el mutex esta
+*	ocupado por otro proceso espera como mucho ticks ticks (sin limite si
+*	ticks es negativo y sin esperar si es 0).
+*/
+static int lock_plazo(unsigned int mutexid, int ticks){
+	int limite = 0;
+	int ha_esperado = 0;
+	int index_mutex_proc = buscar_descriptor_mutex_proc(mutexid);
 
-	escribir_ker(texto, longi);
-	return 0;
+	if(index_mutex_proc < 0){
+		printk("--->ERROR: El proceso %d no tiene el mutex %d\n", p_proc_actual->id, mutexid);
+		return ERROR_MUTEX_NO_EXISTE;
+	}
+
+	Mutex *mutex = tabla_mutex[mutexid];
+	palabra_mutex *palabra = &mutex->palabra;
+	if(mutex->clase != CLASE_MUTEX){
+		printk("--->ERROR: LOCK sobre %s, que no es un mutex\n", mutex->nombre);
+		return ERROR_TIPO_MUTEX;
+	}
+	printk("-> PROC %d: LOCK MUTEX %s\n", p_proc_actual->id, mutex->nombre);
+	printk("---> TRABAJAMOS CON EL DESCRIPTOR %d del MUTEX %s\n", mutexid, mutex->nombre);
+
+	if(ticks > 0){
+		// En un periodo largo del reloj sin ticks se pone al dia num_int_reloj
+		ajustar_reloj();
+		limite = num_int_reloj + ticks;
+	}
+
+	while(palabra->cerrojo != CERROJO_LIBRE && PROPIETARIO(palabra->cerrojo) != p_proc_actual->id){
+		if(ticks == 0){
+			printk("--> PROC %d: MUTEX %s OCUPADO. NO ESPERA\n", p_proc_actual->id, mutex->nombre);
+			return ERROR_MUTEX_OCUPADO;
+		}
+		if(ticks > 0 && limite <= num_int_reloj){
+			printk("--> PROC %d: VENCE EL PLAZO DE LOCK DEL MUTEX %s\n", p_proc_actual->id, mutex->nombre);
+			return ERROR_PLAZO_LOCK;
+		}
+		// Bloquear proceso en la lista de procesos bloqueados por este mutex
+		printk("--> PROC %d: BLOQUEADO POR MUTEX %s\n", p_proc_actual->id, mutex->nombre);
+		printk("--> PROC %d: INSERTADO EN COLA DE PROCESOS BLOQUEADOS POR MUTEX %s\n", p_proc_actual->id, mutex->nombre);
+		// El unlock de la biblioteca tendra que entrar al nucleo a despertarlo
+		palabra->cerrojo |= CERROJO_CON_ESPERAS;
+		ha_esperado = 1;
+		p_proc_actual->mutex_esperado = mutex;
+		heredar_prioridad(buscar_proceso(PROPIETARIO(palabra->cerrojo)), p_proc_actual->prioridad);
+		if(ticks < 0)
+			bloquear_proceso(&mutex->procesos_bloqueados);
+		else
+			esperar_plazo(&mutex->procesos_bloqueados, limite - num_int_reloj);
+		p_proc_actual->mutex_esperado = NULL;
+		// Si ha vencido el plazo, el propietario deja de heredar su prioridad
+		actualizar_herencia(buscar_proceso(PROPIETARIO(palabra->cerrojo)));
+	}
+
+	// Con traspaso, el unlock que le ha despertado ya le ha dado el mutex
+	if(ha_esperado && PROPIETARIO(palabra->cerrojo) == p_proc_actual->id){
+		printk("----> PROC %d: RECIBE MUTEX %s POR TRASPASO\n", p_proc_actual->id, mutex->nombre);
+		return 0;
+	}
+
+	// Primera vez que hace lock, asociamos proceso a mutex
+	if(palabra->cerrojo == CERROJO_LIBRE){
+		printk("----> ACTUALIZACION: PROC %d BLOQUEA MUTEX %s\n", p_proc_actual->id, mutex->nombre);
+		palabra->cerrojo = CERROJO_DE(p_proc_actual->id);
+		if(mutex->procesos_bloqueados.primero != NULL)
+			palabra->cerrojo |= CERROJO_CON_ESPERAS;
+		palabra->n_veces = 1;
+		printk("----> PROC %d: LOCK N %d del MUTEX %s\n", p_proc_actual->id, palabra->n_veces, mutex->nombre);
+		return 0;
+	}
+
+	if(palabra->tipo == RECURSIVO){
+		palabra->n_veces++;
+		printk("----> PROC %d: LOCK RECURSIVO N %d del MUTEX %s\n", p_proc_actual->id, palabra->n_veces, mutex->nombre);
+		return 0;
+	}
+	printk("--> ERROR: LOCK Nº %d sobre MUTEX %s NO_RECURSIVO\n", palabra->n_veces, mutex->nombre);
+	return ERROR_GENERICO;
 }
 
-/*
- * Tratamiento de llamada al sistema terminar_proceso. Llama a la
- * funcion auxiliar liberar_proceso
- */
-int sis_terminar_proceso(){
-	printk("-> FIN PROCESO %d\n", p_proc_actual->id);
-	liberar_proceso();
-    return 0; /* no debera llegar aqui */
+/**
+*	Llamada que intenta bloquear mutex del sistema. 
+*	Si el mutex ya está bloqueado por otro proceso, el proceso que realiza la operación se bloquea. 
+*	En caso contrario se bloquea el mutex sin bloquear al proceso.
+*/
+int lock(){
+	unsigned int mutexid = (unsigned int) leer_registro(1);
+	return lock_plazo(mutexid, -1);
 }
-//-----------------------------------------------------------------------------------------
 
 /**
-* Funcion que retorna el id del proceso que la invoca
+*	Como lock, pero si el mutex esta bloqueado por otro proceso no espera y
+*	devuelve ERROR_MUTEX_OCUPADO.
 */
-int obtener_id_pr(){
-	return p_proc_actual->id;
+int trylock(){
+	unsigned int mutexid = (unsigned int) leer_registro(1);
+	return lock_plazo(mutexid, 0);
 }
 
 /**
-* Llamada que permita que un proceso pueda qudarse bloqueado un plazo de tiempo
+*	Como lock, pero espera como mucho el numero de milisegundos indicado
+*	(redondeado hacia arriba a ticks). Si vence el plazo devuelve
+*	ERROR_PLAZO_LOCK. Con 0 milisegundos equivale a trylock.
 */
-int dormir(){
-	unsigned int segundos = (unsigned int) leer_registro(1);
-	//printk("-> PROC %d: DORMIR %d SEGUNDOS\n", p_proc_actual->id, segundos);
-	// Fijar nivel de interrupción a 3
-	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+int lock_timeout(){
+	unsigned int mutexid = (unsigned int) leer_registro(1);
+	unsigned int milisegs = (unsigned int) leer_registro(2);
+	return lock_plazo(mutexid, ms_a_ticks(milisegs));
+}
 
-	BCP *p_proc = p_proc_actual;
-	p_proc->estado = BLOQUEADO;
-	// Los procesos duerment el numero de ticks apropiados
-	p_proc->dormir = segundos*TICK;
+/**
+*	Llamada que intenta desbloquearbloquear al sistema. 
+*	Si el mutex ya está bloqueado por otro proceso, el proceso que realiza la operación se bloquea. 
+*	En caso contrario se bloquea el mutex sin bloquear al proceso.
+*/
+int unlock(){
+	unsigned int mutexid = (unsigned int) leer_registro(1);
+	int index_mutex_proc = buscar_descriptor_mutex_proc(mutexid);
 
-	// Reajustar listas BCP (primero se elimina y luego se inserta)
-	eliminar_primero(&lista_listos);
-	insertar_ultimo(&lista_bloq_dormir, p_proc);
+	if(index_mutex_proc < 0){
+		printk("--->ERROR: El proceso %d no tiene el mutex %d\n", p_proc_actual->id, mutexid);
+		return ERROR_MUTEX_NO_EXISTE;
+	}
 
+	Mutex *mutex = tabla_mutex[mutexid];
+	palabra_mutex *palabra = &mutex->palabra;
+	if(mutex->clase != CLASE_MUTEX){
+		printk("--->ERROR: UNLOCK sobre %s, que no es un mutex\n", mutex->nombre);
+		return ERROR_TIPO_MUTEX;
+	}
+	printk("-> PROC %d: UNLOCK MUTEX %s\n", p_proc_actual->id, mutex->nombre);
+	printk("---> TRABAJAMOS CON EL DESCRIPTOR %d del MUTEX %s\n", mutexid, mutex->nombre);
 
-	// Cambio contexto voluntario
-	p_proc_actual = planificador();
-	cambio_contexto(&(p_proc->contexto_regs), &(p_proc_actual->contexto_regs));
-	
-	// Restaurar nivel de interrupción
-	fijar_nivel_int(nivel_interrupcion_previo);
+	if(PROPIETARIO(palabra->cerrojo) != p_proc_actual->id){
+		printk("--> ERROR: UNLOCK sobre MUTEX %s QUE NO TENIA PROC %d NO TENIA LOCKED\n", mutex->nombre, p_proc_actual->id);
+		return ERROR_GENERICO;
+	}
 
+	printk("----> PROC %d: TIENE MUTEX %s OCUPADO Y VA A DESBLOQUEARLO\n", p_proc_actual->id, mutex->nombre);
+	palabra->n_veces--;
+	if(palabra->n_veces > 0){
+		printk("----> PROC %d: UNLOCK RECURSIVO N %d del MUTEX %s\n", p_proc_actual->id, palabra->n_veces, mutex->nombre);
+		return 0;
+	}
+
+	printk("----> PROC %d: ULTIMO UNLOCK Y DESBLOQUEA\n", p_proc_actual->id);
+	BCP *p_proc = primer_esperando(mutex);
+	if(p_proc != NULL && modo_traspaso_mutex){
+		// Traspaso al primero que espera antes de despertarlo
+		printk("----> PROC %d TRASPASA a %d el MUTEX %s\n", p_proc_actual->id, p_proc->id, mutex->nombre);
+		palabra->cerrojo = CERROJO_DE(p_proc->id);
+		palabra->n_veces = 1;
+		p_proc->mutex_esperado = NULL;
+		desbloquear_proceso(&mutex->procesos_bloqueados, p_proc);
+		if(mutex->procesos_bloqueados.primero != NULL)
+			palabra->cerrojo |= CERROJO_CON_ESPERAS;
+		// El nuevo propietario hereda de los que siguen esperando
+		actualizar_herencia(p_proc);
+		actualizar_herencia(p_proc_actual);
+		return 0;
+	}
+	palabra->cerrojo = CERROJO_LIBRE;
+	// Desbloqueamos procesos que estaban bloqueados
+	if(p_proc != NULL){
+		printk("----> PROC %d DESBLOQUEA a %d por MUTEX %s\n", p_proc_actual->id, p_proc->id, mutex->nombre);
+		p_proc->mutex_esperado = NULL;
+		desbloquear_proceso(&mutex->procesos_bloqueados, p_proc);
+	}
+	actualizar_herencia(p_proc_actual);
 	return 0;
 }
 
-void tratamiento_int_dormir(){
-	//printk("-> TRATANDO INT. DE RELOJ PARA PROCESOS DORMIDOS\n");
+/*
+ * Tratamiento de llamada al sistema datos_mutex, usada por la biblioteca
+ * para obtener la palabra de un mutex abierto por el proceso, sobre la
+ * que hace lock y unlock sin entrar al nucleo mientras no haya
+ * competencia, y la direccion de id_proc_en_ejecucion. Devuelve 0 o un
+ * numero negativo si el proceso no tiene abierto el mutex. La biblioteca
+ * guarda la palabra junto con su generacion, que cerrar_mutex cambia, y
+ * deja de usarla sin preguntar al nucleo en cuanto algun proceso lo cierra.
+ */
+int datos_mutex(){
+	unsigned int mutexid = (unsigned int) leer_registro(1);
+	palabra_mutex **palabra = (palabra_mutex **) leer_registro(2);
+	int **id = (int **) leer_registro(3);
 
-	BCP *p_proc = lista_bloq_dormir.primero;
-	BCP *siguiente = NULL;
+	if(buscar_descriptor_mutex_proc(mutexid) < 0 || palabra == NULL || id == NULL)
+		return ERROR_MUTEX_NO_EXISTE;
+	// Los rwlock y semaforos siempre se operan en el nucleo
+	if(tabla_mutex[mutexid]->clase != CLASE_MUTEX)
+		return ERROR_TIPO_MUTEX;
+	// Flag para saber que estamos en zona de memoria de proceso usuario
+	zona_mem_proc_usuario = 1;
+	*palabra = &tabla_mutex[mutexid]->palabra;
+	*id = &id_proc_en_ejecucion;
+	zona_mem_proc_usuario = 0;
+	return 0;
+}
 
-	while(p_proc != NULL){
-		siguiente = p_proc->siguiente;
-		p_proc->dormir--;
-		if(p_proc->dormir == 0){
-			int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+/*
+*	Funcion auxiliar de las llamadas sobre rwlocks y semaforos. Devuelve la
+*	posicion del descriptor en los del proceso o un numero negativo si no
+*	lo tiene abierto o es de otra clase.
+*/
+static int buscar_clase_proc(unsigned int id, int clase){
+	int index_mutex_proc = buscar_descriptor_mutex_proc(id);
 
-			p_proc->estado = LISTO;
-			eliminar_elem(&lista_bloq_dormir, p_proc);
-			insertar_ultimo(&lista_listos, p_proc);
-			
-			fijar_nivel_int(nivel_interrupcion_previo);
-		
-		}
-		p_proc = siguiente;
+	if(index_mutex_proc < 0){
+		printk("--->ERROR: El proceso %d no tiene el descriptor %d\n", p_proc_actual->id, id);
+		return ERROR_MUTEX_NO_EXISTE;
 	}
+	if(tabla_mutex[id]->clase != clase){
+		printk("--->ERROR: El descriptor %d es de otra clase\n", id);
+		return ERROR_TIPO_MUTEX;
+	}
+	return index_mutex_proc;
 }
 
 /**
-* Llamada que devuelve el numero de interrupciones que se han producio desde que arrancó el sistema. 
-* Si recibe un puntero no nulo, devuelve cuantas veces en la interrupcion de reloj se ha detectado que el proceso estaba ejecutado en modo usuario (campo usuario) y cuantas en modo sistema (campo sistema).
-* Si no hay proceso listo, estará ejecutando el último que se bloqueó. En este caso, no hay que imputarle tiempo de ejecución.
+*	Obtiene el rwlock para lectura. Espera mientras lo tenga un escritor y,
+*	con preferencia de escritores, mientras esperen escritores (salvo que
+*	el proceso ya lo tenga para lectura, para no bloquearse a si mismo).
 */
-int tiempos_proceso(){
-	//printk("-> PROC %d: TIEMPOS PROCESO\n", p_proc_actual->id);
-	struct tiempos_ejec *t_ejec = (struct tiempos_ejec *) leer_registro(1);
-	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-	if(t_ejec != NULL){
-		// Flag para saber que estamos en zona de memoria de proceso usuario
-		zona_mem_proc_usuario = 1;
-		t_ejec->usuario = p_proc_actual->tiempo_usuario;
-		t_ejec->sistema = p_proc_actual->tiempo_sistema;
-		zona_mem_proc_usuario = 0;
+int rdlock(){
+	unsigned int rwlockid = (unsigned int) leer_registro(1);
+	int index_mutex_proc = buscar_clase_proc(rwlockid, CLASE_RWLOCK);
+
+	if(index_mutex_proc < 0)
+		return index_mutex_proc;
+	Mutex *rw = tabla_mutex[rwlockid];
+	printk("-> PROC %d: RDLOCK RWLOCK %s\n", p_proc_actual->id, rw->nombre);
+	if(PROPIETARIO(rw->palabra.cerrojo) == p_proc_actual->id){
+		printk("--> ERROR: RDLOCK sobre RWLOCK %s QUE TIENE PARA ESCRITURA\n", rw->nombre);
+		return ERROR_GENERICO;
 	}
-	fijar_nivel_int(nivel_interrupcion_previo);
-	return num_int_reloj;
-}
-void tratamiento_uso_procesador(){
-	//printk("-> SUMANDO TICKS AL PROCESO\n");
-	BCPptr p_proc = lista_listos.primero;
-	if(p_proc != NULL){
-		if(viene_de_modo_usuario()){
-			p_proc_actual->tiempo_usuario++;
-		}else{
-			p_proc_actual->tiempo_sistema++;
-		}
+
+	while(rw->palabra.cerrojo != CERROJO_LIBRE ||
+			(rw->preferencia == PREFERENCIA_ESCRITORES && rw->procesos_bloqueados.primero != NULL &&
+			p_proc_actual->lecturas_rwlock[index_mutex_proc] == 0)){
+		printk("--> PROC %d: LECTOR BLOQUEADO POR RWLOCK %s\n", p_proc_actual->id, rw->nombre);
+		bloquear_proceso(&rw->lectores_bloqueados);
 	}
+	rw->n_lectores++;
+	p_proc_actual->lecturas_rwlock[index_mutex_proc]++;
+	p_proc_actual->mutex_abiertos->lecturas[index_mutex_proc]++;
+	printk("----> PROC %d: RDLOCK del RWLOCK %s. LECTORES %d\n", p_proc_actual->id, rw->nombre, rw->n_lectores);
+	return 0;
 }
 
 /**
-* Crear mutex con el nombre y tipo especificados.
-* Devuelve un entero que representa un descriptor para acceder al mutex. En caso de error devuelve un numero negativo.
+*	Obtiene el rwlock para escritura, esperando a que no lo tenga nadie.
+*	Es un error si el proceso ya lo tiene para lectura o escritura.
 */
-int crear_mutex(){
-	char *nombre = strdup((char *) leer_registro(1));
-	int tipo = (int) leer_registro(2);
-	printk("-> PROC %d: CREAR MUTEX %s\n", p_proc_actual->id, nombre);
-
-	// Comprobar que el nombre no sea demasiado largo
-	if(len(nombre) > MAX_NOM_MUT){
-		printk("--->ERROR: El nombre del mutex es demasiado largo\n");
-		return ERROR_LONGITUD_NOMBRE;
+int wrlock(){
+	unsigned int rwlockid = (unsigned int) leer_registro(1);
+	int index_mutex_proc = buscar_clase_proc(rwlockid, CLASE_RWLOCK);
+
+	if(index_mutex_proc < 0)
+		return index_mutex_proc;
+	Mutex *rw = tabla_mutex[rwlockid];
+	printk("-> PROC %d: WRLOCK RWLOCK %s\n", p_proc_actual->id, rw->nombre);
+	if(PROPIETARIO(rw->palabra.cerrojo) == p_proc_actual->id ||
+			p_proc_actual->lecturas_rwlock[index_mutex_proc] > 0){
+		printk("--> ERROR: WRLOCK sobre RWLOCK %s QUE YA TIENE PROC %d\n", rw->nombre, p_proc_actual->id);
+		return ERROR_GENERICO;
 	}
 
-	// Comprobar que proceso no tiene mas de NUM_MUT_PROC
-	if(p_proc_actual->num_mutex >= NUM_MUT_PROC){
-		printk("--->ERROR: El proceso %d tiene demasiados mutex\n", p_proc_actual->id);
-		return ERROR_MAX_NUM_MUTEX_PROC;
-	}
-	printk("--> PROC %d: INTENTA CREAR MUTEX %s\n", p_proc_actual->id, nombre);
-	// Comprobar que no se ha alcanzado el maximo numero de mutex
-	while(num_mutex_global >= NUM_MUT){
-		printk("--->ERROR: Creando %s. Se ha alcanzado el maximo numero de mutex, %d \n", nombre, num_mutex_global);
-		esperar_hueco_mutex(nombre);
+	while(rw->palabra.cerrojo != CERROJO_LIBRE || rw->n_lectores > 0){
+		printk("--> PROC %d: ESCRITOR BLOQUEADO POR RWLOCK %s\n", p_proc_actual->id, rw->nombre);
+		bloquear_proceso(&rw->procesos_bloqueados);
 	}
-	// Volvemos a cogerlo por si nos bloqueamos para que se actualice el descriptor
-	int descriptor_mutex = buscar_mutex_libre_y_no_repetido(nombre);
-	int error;
-	if ((error = cumple_requisitos(nombre, descriptor_mutex)) < 0){
-		return error;
-	}
-
-
-	// Crear mutex
-	Mutex *mutex;
-	mutex = &tabla_mutex[descriptor_mutex];
-	mutex->tipo = tipo;
-	mutex->estado = LIBRE;
-	mutex->procs_asociados[mutex->n_proc_asociados] = p_proc_actual->id;
-	cpy(mutex->nombre, nombre);
+	rw->palabra.cerrojo = CERROJO_DE(p_proc_actual->id);
+	rw->palabra.n_veces = 1;
+	printk("----> PROC %d: WRLOCK del RWLOCK %s\n", p_proc_actual->id, rw->nombre);
+	return 0;
+}
 
-	// Asociar mutex al proceso
-	int pos_mutex_proc = obtener_mutex_proc();
-	p_proc_actual->descriptores_mutex[pos_mutex_proc] = descriptor_mutex;
+/**
+*	Libera el rwlock que el proceso tiene para escritura o una de las
+*	lecturas que tiene, despertando a los que puedan obtenerlo.
+*/
+int rwunlock(){
+	unsigned int rwlockid = (unsigned int) leer_registro(1);
+	int index_mutex_proc = buscar_clase_proc(rwlockid, CLASE_RWLOCK);
+
+	if(index_mutex_proc < 0)
+		return index_mutex_proc;
+	Mutex *rw = tabla_mutex[rwlockid];
+	printk("-> PROC %d: RWUNLOCK RWLOCK %s\n", p_proc_actual->id, rw->nombre);
+	if(PROPIETARIO(rw->palabra.cerrojo) != p_proc_actual->id &&
+			p_proc_actual->lecturas_rwlock[index_mutex_proc] == 0){
+		printk("--> ERROR: RWUNLOCK sobre RWLOCK %s QUE NO TIENE PROC %d\n", rw->nombre, p_proc_actual->id);
+		return ERROR_GENERICO;
+	}
+	soltar_rwlock(rw, index_mutex_proc, 0);
+	return 0;
+}
 
-	// Actualizar estados
-	mutex->n_proc_asociados++;
-	printk("----> ACTUALIZACION: MUTEX %s TIENE %d PROCESOS ASOCIADOS\n", mutex->nombre, mutex->n_proc_asociados);
-	p_proc_actual->num_mutex++;
-	printk("----> ACTUALIZACION: PROC %d TIENE %d MUTEX ASOCIADOS\n", p_proc_actual->id, p_proc_actual->num_mutex);
-	num_mutex_global++;
-	printk("----> ACTUALIZACION: MUTEX EN SISTEMA %d\n", num_mutex_global);
+/**
+*	Decrementa el semaforo o, si esta a 0, espera a que un sem_post le pase
+*	una unidad.
+*/
+int sis_sem_wait(){
+	unsigned int semid = (unsigned int) leer_registro(1);
+	int index_mutex_proc = buscar_clase_proc(semid, CLASE_SEMAFORO);
+
+	if(index_mutex_proc < 0)
+		return index_mutex_proc;
+	Mutex *sem = tabla_mutex[semid];
+	printk("-> PROC %d: SEM_WAIT SEMAFORO %s CON VALOR %d\n", p_proc_actual->id, sem->nombre, sem->valor);
+	if(sem->valor > 0){
+		sem->valor--;
+		return 0;
+	}
+	// Solo lo despierta el sem_post que le traspasa la unidad
+	printk("--> PROC %d: BLOQUEADO POR SEMAFORO %s\n", p_proc_actual->id, sem->nombre);
+	bloquear_proceso(&sem->procesos_bloqueados);
+	return 0;
+}
 
-	printk("--> MUTEX %s con descriptor %d CREADO: TIENE %d ASOCIADOS \n", mutex->nombre, descriptor_mutex, mutex->n_proc_asociados);
-	printk("--> PROCESO TIENE %d mutex\n", p_proc_actual->num_mutex);
-	printk("-> PROC %d: FIN CREAR MUTEX %d of 16\n", p_proc_actual->id, num_mutex_global);
-	// Devolver descriptor
-	return descriptor_mutex;
+/**
+*	Como sem_wait, pero si el semaforo esta a 0 no espera y devuelve
+*	ERROR_SEM_OCUPADO.
+*/
+int sis_sem_trywait(){
+	unsigned int semid = (unsigned int) leer_registro(1);
+	int index_mutex_proc = buscar_clase_proc(semid, CLASE_SEMAFORO);
+
+	if(index_mutex_proc < 0)
+		return index_mutex_proc;
+	Mutex *sem = tabla_mutex[semid];
+	printk("-> PROC %d: SEM_TRYWAIT SEMAFORO %s CON VALOR %d\n", p_proc_actual->id, sem->nombre, sem->valor);
+	if(sem->valor == 0)
+		return ERROR_SEM_OCUPADO;
+	sem->valor--;
+	return 0;
 }
 
-/*
-*	Funcion auxiliar para comprobar las condiciones de creación de un mutex
+/**
+*	Si esperan procesos en el semaforo traspasa la unidad a uno de ellos
+*	(el primero de los mas prioritarios) y lo despierta; si no, lo
+*	incrementa.
 */
-int cumple_requisitos(char *nombre, int descriptor_mutex){
-	if(descriptor_mutex == ERROR_MAX_NUM_MUTEX){
-		printk("--->ERROR: Se ha alcanzado el maximo numero de mutex\n");
-		return ERROR_MAX_NUM_MUTEX;
+int sis_sem_post(){
+	unsigned int semid = (unsigned int) leer_registro(1);
+	int index_mutex_proc = buscar_clase_proc(semid, CLASE_SEMAFORO);
+
+	if(index_mutex_proc < 0)
+		return index_mutex_proc;
+	Mutex *sem = tabla_mutex[semid];
+	printk("-> PROC %d: SEM_POST SEMAFORO %s CON VALOR %d\n", p_proc_actual->id, sem->nombre, sem->valor);
+	BCP *p_proc = primer_esperando(sem);
+	if(p_proc == NULL){
+		sem->valor++;
+		return 0;
 	}
-	// Comprobar que no existe un mutex con ese nombre
-	if(descriptor_mutex == ERROR_NOMBRE_REPETIDO){
-		printk("--->ERROR: Ya existe un mutex con ese nombre\n");
-		return ERROR_NOMBRE_REPETIDO;
+	printk("----> PROC %d DESPIERTA a %d por SEMAFORO %s\n", p_proc_actual->id, p_proc->id, sem->nombre);
+	desbloquear_proceso(&sem->procesos_bloqueados, p_proc);
+	return 0;
+}
+
+/**
+*	Rutina que actualiza la vida de un proceso (Implementacion de Round Robin)
+*/
+void tratamiento_round_robin(int ticks){
+	if(p_proc_actual->estado == LISTO){
+		if(politica_planif == PLANIF_CFS && !p_proc_actual->en_edf)
+			actualizar_vruntime(p_proc_actual, ticks);
+		else if(politica_planif == PLANIF_STRIDE && !p_proc_actual->en_edf)
+			actualizar_paso(p_proc_actual, ticks);
+		p_proc_actual->vida -= ticks;
+		if(p_proc_actual->vida <= 0){
+			printk("--> PROC %d: VIDA = %d. FIN DE RODAJA. SE ACTIVA INT. SW \n", p_proc_actual->id, p_proc_actual->vida);
+			// Si el proceso ha agotado su tiempo de vida, se activa interrupcion SW
+			id_proc_a_expulsar = p_proc_actual->id;
+			activar_int_SW();
+		}
 	}
-	printk("--> COMPROBAMOS REQUISITIOS Y OBTENEMOS %d\n", descriptor_mutex);
-	return descriptor_mutex;
+	// Proceso bloqueado || nulo no consume su tiempo de vida
 }
 
 /**
-* 	Funcion auxiliar para esperar hasta que haya hueco en la tabla de mutex
+*	Rutina que, en la politica MLFQ, sube periodicamente todos los procesos
+*	al nivel maximo para evitar la inanicion de los que han ido bajando
 */
-void esperar_hueco_mutex(char* nombre){
-	printk("--> PROC %d: ESPERANDO HUECO MUTEX %s\n", p_proc_actual->id, nombre);
-	BCPptr p_proc = p_proc_actual;
-	p_proc->estado = BLOQUEADO;
+void tratamiento_elevacion_mlfq(){
+	if(politica_planif != PLANIF_MLFQ || num_int_reloj < proxima_elevacion)
+		return;
+	proxima_elevacion = num_int_reloj + TICKS_POR_ELEVACION;
+
 	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-	eliminar_elem(&lista_listos, p_proc);
-	insertar_ultimo(&lista_bloq_mutex, p_proc);
-	printk("--> PROC %d: INSERTADO EN COLA DE ESPERA DE MUTEX\n", p_proc->id);
+	// Los listos se anexan al nivel maximo conservando su orden
+	lista_BCPs *lista_maxima = &listas_listos[NUM_PRIORIDADES-1];
+	for(int nivel = NUM_PRIORIDADES-2; nivel >= 0; nivel--){
+		for(BCPptr p_proc = listas_listos[nivel].primero; p_proc != NULL; p_proc = p_proc->siguiente)
+			p_proc->prioridad = NUM_PRIORIDADES-1;
+		concatenar_lista(lista_maxima, &listas_listos[nivel]);
+	}
+	if(lista_maxima->primero != NULL)
+		mapa_listos = 1U << (NUM_PRIORIDADES-1);
+
+	// Los bloqueados volveran a listos en el nivel maximo
+	for(int i = 0; i < num_procs_max; i++){
+		if(tabla_procs[i].estado == BLOQUEADO)
+			tabla_procs[i].prioridad = NUM_PRIORIDADES-1;
+	}
 	fijar_nivel_int(nivel_interrupcion_previo);
-	p_proc_actual = planificador();
-	printk("-->C.CONTEXTO POR BLOQUEO de %d a %d\n",p_proc->id, p_proc_actual->id);
-	cambio_contexto(&(p_proc->contexto_regs), &(p_proc_actual->contexto_regs));
 }
 
-/**
-*	Devuelve un descriptor asociado a un mutex ya existente o un número negativo en caso de error
+/*
+*	Funcion auxiliar de las llamadas de lectura del terminal. Si no hay
+*	caracteres espera como mucho ticks ticks (sin limite si ticks es
+*	negativo y sin esperar si es 0).
 */
-int abrir_mutex(){
-	char *nombre = (char *) leer_registro(1);
-	printk("-> PROC %d: ABRIR MUTEX %s Nº %d\n", p_proc_actual->id, nombre, p_proc_actual->num_mutex);
-	
-	// Comprobar que proceso no tiene mas de NUM_MUT_PROC
-	if(p_proc_actual->num_mutex >= NUM_MUT_PROC){
-		printk("-->ERROR: No tiene hueco para abrir el mutex %s\n", nombre);
-		return ERROR_MAX_NUM_MUTEX_PROC;
+static int leer_caracter_plazo(int ticks){
+	printk("-> PROC %d: LEER_CARACTER\n    BUFFER: %s LENGTH: %d\n", p_proc_actual->id, caracteres.buffer, caracteres.length);
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_2);
+	int limite = 0;
+
+	if(ticks > 0){
+		// En un periodo largo del reloj sin ticks se pone al dia num_int_reloj
+		ajustar_reloj();
+		limite = num_int_reloj + ticks;
 	}
-	// Comprobar que el mutex existe en la tabla de mutex
-	int descriptor_mutex = buscar_mutex(nombre);
-	printk("---> TRABAJAMOS CON EL DESCRIPTOR %d del MUTEX %s\n", descriptor_mutex, nombre);
-	if(descriptor_mutex < 0){
-		printk("--->ERROR: El mutex %s no existe\n", nombre);
-		return ERROR_MUTEX_NO_EXISTE;
+	
+	// Si no hay caracteres en el buffer, bloqueamos el proceso
+	while(caracteres.length == 0) {
+		if(ticks == 0){
+			fijar_nivel_int(nivel_interrupcion_previo);
+			return ERROR_SIN_CARACTERES;
+		}
+		if(ticks > 0 && limite <= num_int_reloj){
+			printk("--> PROC %d: VENCE EL PLAZO DE LECTURA\n", p_proc_actual->id);
+			fijar_nivel_int(nivel_interrupcion_previo);
+			return ERROR_PLAZO_LECTURA;
+		}
+		// Si no hay caracteres en el buffer, bloqueamos el proceso
+		if(ticks < 0)
+			bloquear_proceso(&lista_bloq_caracter);
+		else
+			esperar_plazo(&lista_bloq_caracter, limite - num_int_reloj);
 	}
 
-	if(!esta_mutex_asociado_a_proc(descriptor_mutex)){
-		// Asociar mutex a proceso
-		int index_mutex_proc = obtener_mutex_proc();
-		p_proc_actual->descriptores_mutex[index_mutex_proc] = descriptor_mutex;
+	// Si hay caracteres en el buffer, devolvemos el primero
+	int c = (int) caracteres.buffer[caracteres.puntero_lectura];
+	printk("--> PROC %d: LECTURA CARACTER Nº %d\n", p_proc_actual->id, caracteres_leidos);
+	caracteres.puntero_lectura = (caracteres.puntero_lectura + 1) % TAM_BUF_TERM;
+	printk("---> PROC %d: ACTUALIZACION PUNTERO LECTURA A %d \n", p_proc_actual->id, caracteres.puntero_lectura);
+	caracteres.length--;
+	caracteres_leidos++;
+	fijar_nivel_int(nivel_interrupcion_previo);
+	return c;
 
-		// Asociar proceso a mutex
-		Mutex *mutex = &tabla_mutex[descriptor_mutex];
-		mutex->procs_asociados[mutex->n_proc_asociados] = p_proc_actual->id;
+}
 
-		// Actualizacion de estados
-		p_proc_actual->num_mutex++;
-		printk("----> ACTUALIZACION: PROC %d TIENE %d MUTEX ASOCIADOS\n", p_proc_actual->id, p_proc_actual->num_mutex);
-		mutex->n_proc_asociados++;
-		printk("----> ACTUALIZACION: MUTEX %s TIENE %d PROCESOS ASOCIADOS\n", mutex->nombre, mutex->n_proc_asociados);
-		printk("--> MUTEX %s con descriptor %d ABIERTO: TIENE %d PROCESOS ASOCIADOS \n", nombre, descriptor_mutex, mutex->n_proc_asociados);
+/**
+*	Rutina que descuenta el presupuesto del proceso de tiempo real en
+*	ejecucion. Si lo agota, pasa a competir como un proceso normal hasta
+*	su siguiente periodo.
+*/
+void tratamiento_tiempo_real(int ticks){
+	if(p_proc_actual == NULL || p_proc_actual->estado != LISTO || !p_proc_actual->en_edf)
+		return;
+	p_proc_actual->presupuesto_restante -= ticks;
+	if(p_proc_actual->presupuesto_restante > 0)
+		return;
+
+	printk("--> PROC %d: AGOTA SU PRESUPUESTO DE TIEMPO REAL\n", p_proc_actual->id);
+	p_proc_actual->excesos_presupuesto++;
+	eliminar_listo(p_proc_actual);
+	insertar_listo(p_proc_actual);
+	if(primer_listo() != p_proc_actual){
+		id_proc_a_expulsar = p_proc_actual->id;
+		activar_int_SW();
 	}
+}
 
-	printk("--> PROCESO TIENE %d mutex\n", p_proc_actual->num_mutex);
-	printk("-> PROC %d: FIN ABRIR MUTEX %s. PROCESO TIENE ASOCIADOS %d MUTEXES Y DEVOLVEMOS DESCRIPTOR %d\n", p_proc_actual->id, nombre, p_proc_actual->num_mutex, descriptor_mutex);
+/*
+*	Lee caracter del terminal y lo devuelve como resultado
+*/
+int leer_caracter(){
+	return leer_caracter_plazo(-1);
+}
 
-	return descriptor_mutex;
+/*
+*	Como leer_caracter, pero espera como mucho el numero de milisegundos
+*	indicado (redondeado hacia arriba a ticks). Si vence el plazo devuelve
+*	ERROR_PLAZO_LECTURA.
+*/
+int leer_caracter_timeout(){
+	unsigned int milisegs = (unsigned int) leer_registro(1);
+	int ticks = ms_a_ticks(milisegs);
+
+	if(ticks == 0)
+		ticks = 1;
+	return leer_caracter_plazo(ticks);
 }
 
 /*
-* 	Funcion auxiliar para ver si el mutex está asociado
-* 	Devuelve 1 si lo encuentra || 0 si no lo encuentra
+*	Lee caracter del terminal sin bloquearse. Si no hay ninguno devuelve
+*	ERROR_SIN_CARACTERES.
 */
-int esta_mutex_asociado_a_proc(int des){
-	int encontrado = 0;
-	int i = 0;
-	while(!encontrado && i < NUM_MUT_PROC){
-		if(p_proc_actual->descriptores_mutex[i] == des){
-			encontrado = 1;
-		}
-		i++;
-	}
-	return encontrado;
+int leer_caracter_no_bloq(){
+	return leer_caracter_plazo(0);
 }
 
 /**
-* 	 Cierra el mutex especificado, devolviendo un número negativo en caso de error.
+*	Fija la prioridad del proceso que la invoca (0 la minima, NUM_PRIORIDADES-1 la maxima).
+*	Devuelve la prioridad anterior o un numero negativo en caso de error.
 */
-int cerrar_mutex(){
-	unsigned int mutexid = (unsigned int) leer_registro(1);
-	Mutex *mutex = &tabla_mutex[mutexid];
-	printk("-> PROC %d: CERRAR MUTEX %s\n", p_proc_actual->id, mutex->nombre);
-	
-	int index_mutex_proc = buscar_descriptor_mutex_proc(mutexid);
-	printk("---> TRABAJAMOS CON EL DESCRIPTOR %d del MUTEX %s\n", mutexid, mutex->nombre);
+int fijar_prioridad(){
+	int prioridad = (int) leer_registro(1);
+	printk("-> PROC %d: FIJAR PRIORIDAD %d\n", p_proc_actual->id, prioridad);
 
-	if(index_mutex_proc < 0){
-		printk("--->ERROR: El proceso %d no tiene el mutex %s\n", p_proc_actual->id, mutex->nombre);
-		return ERROR_MUTEX_NO_EXISTE;
+	if(prioridad < 0 || prioridad >= NUM_PRIORIDADES){
+		printk("--->ERROR: La prioridad %d no es valida\n", prioridad);
+		return ERROR_PRIORIDAD;
 	}
 
-	// Desasociar proceso al mutex
-	int encontrado = 0;
-	int index = 0;
-	while(index < MAX_PROC && !encontrado){
-		if(mutex->procs_asociados[index] == p_proc_actual->id){
-			mutex->procs_asociados[index] = NO_USADO;
-			encontrado = 1;
-		}
-		index++;
-	}
-	mutex->n_proc_asociados--;
-	printk("----> ACTUALIZACION: MUTEX %s TIENE %d PROCESOS ASOCIADOS\n", mutex->nombre, mutex->n_proc_asociados);
+	int prioridad_anterior = p_proc_actual->prioridad;
+	if(politica_planif == PLANIF_PRIORIDADES)
+		prioridad_anterior = p_proc_actual->prioridad_base; // sin la heredada
+	p_proc_actual->prioridad_base = prioridad;
+	// Conserva la heredada de los que esperan los mutex que tiene
+	aplicar_prioridad(p_proc_actual, prioridad_efectiva(p_proc_actual));
 
-	// Si proceso tenia bloqueado mutex, desbloquear procesos
-	if(mutex->estado == OCUPADO && mutex->id_proceso_lock == p_proc_actual->id){
-		printk("----> PROC %d: UNLOCK IMPLICITO\n", p_proc_actual->id);
-		mutex->n_veces_lock = 1; // Para que desbloque todos los procesos
-		escribir_registro(1,mutexid);
-		unlock();
+	return prioridad_anterior;
+}
+
+
+/**
+*	Fija la rodaja (en ticks, entre RODAJA_MINIMA y RODAJA_MAXIMA) del
+*	proceso que la invoca. Si adaptativa vale 1, a partir de ese valor el
+*	sistema la duplica cada vez que el proceso la agota y la reduce a la
+*	mitad cada vez que se bloquea sin haber usado la mitad.
+*	Devuelve la rodaja anterior o un numero negativo en caso de error.
+*	La nueva rodaja se aplica a partir de la siguiente vez que se planifique.
+*/
+int fijar_rodaja(){
+	int rodaja = (int) leer_registro(1);
+	int adaptativa = (int) leer_registro(2);
+	printk("-> PROC %d: FIJAR RODAJA %d (ADAPTATIVA %d)\n", p_proc_actual->id, rodaja, adaptativa);
+
+	if(rodaja < RODAJA_MINIMA || rodaja > RODAJA_MAXIMA || (adaptativa != 0 && adaptativa != 1)){
+		printk("--->ERROR: La rodaja %d no es valida\n", rodaja);
+		return ERROR_RODAJA;
 	}
 
+	int rodaja_anterior = p_proc_actual->rodaja;
+	p_proc_actual->rodaja = rodaja;
+	p_proc_actual->rodaja_adaptativa = adaptativa;
+	return rodaja_anterior;
+}
 
-	// Si es el ultimo proceso en estar asociado, eliminamos mutex
-	if(mutex->n_proc_asociados == 0){
-		mutex->estado = NO_USADO;
-		cpy(mutex->nombre, "");
-		num_mutex_global--;
-		printk("----> ACTUALIZACION: MUTEX EN SISTEMA %d\n", num_mutex_global);
+/**
+*	Devuelve la rodaja actual del proceso que la invoca, si esta en modo
+*	adaptativo y cuantas veces ha agotado la rodaja o se ha bloqueado sin
+*	usar la mitad. Devuelve 0 o un numero negativo si el puntero es nulo.
+*/
+int info_rodaja(){
+	struct info_rodaja *info = (struct info_rodaja *) leer_registro(1);
 
-	}
+	if(info == NULL)
+		return ERROR_GENERICO;
+	// Flag para saber que estamos en zona de memoria de proceso usuario
+	zona_mem_proc_usuario = 1;
+	info->rodaja = p_proc_actual->rodaja;
+	info->adaptativa = p_proc_actual->rodaja_adaptativa;
+	info->rodajas_agotadas = p_proc_actual->rodajas_agotadas;
+	info->bloqueos_tempranos = p_proc_actual->bloqueos_tempranos;
+	zona_mem_proc_usuario = 0;
+	return 0;
+}
 
-	// Desasociar mutex al proceso
-	p_proc_actual->descriptores_mutex[index_mutex_proc] = NO_USADO;
-	p_proc_actual->num_mutex--;
-	printk("----> ACTUALIZACION: PROC %d TIENE %d MUTEX ASOCIADOS\n", p_proc_actual->id, p_proc_actual->num_mutex);
-	
-	BCPptr p_proc = lista_bloq_mutex.primero;
-	if(p_proc != NULL){
-		// Desbloquear procesos bloqueados por el mutex
-		printk("---> DESBLOQUEANDO a proc %d por MUTEX %s con descriptor %d\n", p_proc->id, mutex->nombre, mutexid);
-		p_proc->estado = LISTO;
-		int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-		eliminar_primero(&lista_bloq_mutex);
-		insertar_ultimo(&lista_listos, p_proc);
-		fijar_nivel_int(nivel_interrupcion_previo);
+/**
+*	Fija el valor nice (de NICE_MINIMO a NICE_MAXIMO) del proceso que la
+*	invoca, que determina su peso en la politica CFS. Con otras politicas
+*	solo se guarda. Devuelve el valor anterior o un numero negativo en caso
+*	de error.
+*/
+int fijar_nice(){
+	int nice = (int) leer_registro(1);
+	printk("-> PROC %d: FIJAR NICE %d\n", p_proc_actual->id, nice);
+
+	if(nice < NICE_MINIMO || nice > NICE_MAXIMO){
+		printk("--->ERROR: El valor nice %d no es valido\n", nice);
+		return ERROR_NICE;
 	}
-	
-	printk("--> MUTEX %s con descriptor %d CERRADO: TIENE %d PROCESOS ASOCIADOS \n", mutex->nombre, mutexid, mutex->n_proc_asociados);
-	printk("--> PROCESO TIENE %d mutex\n", p_proc_actual->num_mutex);
-	printk("-> PROC %d: FIN CERRAR MUTEX %s. PROCESO TIENE ASOCIADOS %d MUTEXES Y DEVOLVEMOS DESCRIPTOR %d\n", p_proc_actual->id, mutex->nombre, p_proc_actual->num_mutex, mutexid);
-	
-	return 0;
+
+	int nice_anterior = p_proc_actual->nice;
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	// Si el proceso esta en el monticulo, cambia el peso total de los listos
+	int en_monticulo = usa_monticulo() && !p_proc_actual->en_edf;
+	if(en_monticulo)
+		peso_total_listos -= p_proc_actual->peso;
+	p_proc_actual->nice = nice;
+	p_proc_actual->peso = pesos_nice[nice - NICE_MINIMO];
+	if(en_monticulo)
+		peso_total_listos += p_proc_actual->peso;
+	fijar_nivel_int(nivel_interrupcion_previo);
+
+	return nice_anterior;
 }
 
 /**
-*	Llamada que intenta bloquear mutex del sistema. 
-*	Si el mutex ya está bloqueado por otro proceso, el proceso que realiza la operación se bloquea. 
-*	En caso contrario se bloquea el mutex sin bloquear al proceso.
+*	Declara al proceso que la invoca como periodico de tiempo real con el
+*	periodo, presupuesto (ticks de CPU por periodo) y plazo relativo
+*	indicados, en ticks, de modo que presupuesto <= plazo <= periodo. El
+*	primer periodo empieza en ese momento. Con periodo 0 el proceso deja
+*	la clase de tiempo real. Devuelve ERROR_ADMISION_TR si con el proceso
+*	la utilizacion total superaria el 100%.
 */
-int lock(){
-	unsigned int mutexid = (unsigned int) leer_registro(1);
-	Mutex *mutex = &tabla_mutex[mutexid];
-	printk("-> PROC %d: LOCK MUTEX %s\n", p_proc_actual->id, mutex->nombre);
-	
-	int index_mutex_proc = buscar_descriptor_mutex_proc(mutexid);
-	printk("---> TRABAJAMOS CON EL DESCRIPTOR %d del MUTEX %s\n", mutexid, mutex->nombre);
+int fijar_tiempo_real(){
+	int periodo = (int) leer_registro(1);
+	int presupuesto = (int) leer_registro(2);
+	int plazo = (int) leer_registro(3);
+	BCPptr p_proc = p_proc_actual;
+	int utilizacion = 0;
+	printk("-> PROC %d: FIJAR TIEMPO REAL P %d C %d D %d\n", p_proc->id, periodo, presupuesto, plazo);
 
-	if(index_mutex_proc < 0){
-		printk("--->ERROR: El proceso %d no tiene el mutex %s\n", p_proc_actual->id, mutex->nombre);
-		return ERROR_MUTEX_NO_EXISTE;
+	if(periodo != 0){
+		if(presupuesto < 1 || plazo < presupuesto || periodo < plazo){
+			printk("--->ERROR: Parametros de tiempo real no validos\n");
+			return ERROR_PARAMETROS_TR;
+		}
+		utilizacion = (int)(((long long)presupuesto*UTILIZACION_MAXIMA + periodo-1) / periodo);
 	}
 
-	while(mutex->estado == OCUPADO && mutex->id_proceso_lock != p_proc_actual->id){
-		// Bloquear proceso en la lista de procesos bloqueados por este mutex
-		printk("--> PROC %d: BLOQUEADO POR MUTEX %s\n", p_proc_actual->id, mutex->nombre);
-		BCPptr p_proc = p_proc_actual;
-		p_proc->estado = BLOQUEADO;
-		int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-		eliminar_elem(&lista_listos, p_proc);
-		insertar_ultimo(&mutex->procesos_bloqueados, p_proc);
-		printk("--> PROC %d: INSERTADO EN COLA DE PROCESOS BLOQUEADOS POR MUTEX %s\n", p_proc->id, mutex->nombre);
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	int utilizacion_previa = p_proc->tiempo_real ? p_proc->utilizacion : 0;
+	if(utilizacion_tr - utilizacion_previa + utilizacion > UTILIZACION_MAXIMA){
+		printk("--->ERROR: Utilizacion de tiempo real %d + %d excede el maximo\n", utilizacion_tr - utilizacion_previa, utilizacion);
 		fijar_nivel_int(nivel_interrupcion_previo);
-		p_proc_actual = planificador();
-		printk("-->C.CONTEXTO POR LOCK de %d a %d\n",p_proc->id, p_proc_actual->id);
-		cambio_contexto(&(p_proc->contexto_regs), &(p_proc_actual->contexto_regs));
+		return ERROR_ADMISION_TR;
 	}
 
-	// Primera vez que hace lock, asociamos proceso a mutex
-	if(mutex->estado == LIBRE){
-		printk("----> ACTUALIZACION: PROC %d BLOQUEA MUTEX %s\n", p_proc_actual->id, mutex->nombre);
-		mutex->id_proceso_lock = p_proc_actual->id;
+	// En un periodo largo del reloj sin ticks se pone al dia num_int_reloj
+	ajustar_reloj();
+	// El proceso sigue listo: se saca de su cola y se vuelve a insertar en la que le corresponde
+	eliminar_listo(p_proc);
+	utilizacion_tr += utilizacion - utilizacion_previa;
+	p_proc->tiempo_real = (periodo != 0);
+	p_proc->periodo = periodo;
+	p_proc->presupuesto = presupuesto;
+	p_proc->plazo_relativo = plazo;
+	p_proc->utilizacion = utilizacion;
+	p_proc->proximo_periodo = num_int_reloj + periodo;
+	p_proc->plazo_absoluto = num_int_reloj + plazo;
+	p_proc->presupuesto_restante = presupuesto;
+	insertar_listo(p_proc);
+	if(primer_listo() != p_proc){
+		id_proc_a_expulsar = p_proc->id;
+		activar_int_SW();
 	}
+	fijar_nivel_int(nivel_interrupcion_previo);
 
-	if(mutex->id_proceso_lock == p_proc_actual->id){
-		if(mutex->tipo == RECURSIVO){
-			mutex->id_proceso_lock = p_proc_actual->id;
-			mutex->estado = OCUPADO;
-			mutex->n_veces_lock++;
-			printk("----> PROC %d: LOCK RECURSIVO N %d del MUTEX %s\n", p_proc_actual->id, mutex->n_veces_lock, mutex->nombre);
-		}else{
-			// MUTEX NO_RECURSIVO
-			if(mutex->n_veces_lock == 0 && mutex->estado == LIBRE){
-				mutex->id_proceso_lock = p_proc_actual->id;
-				mutex->estado = OCUPADO;
-				mutex->n_veces_lock++;
-				printk("----> PROC %d: LOCK NO_RECURSIVO N %d del MUTEX %s\n", p_proc_actual->id, mutex->n_veces_lock, mutex->nombre);
-
-			}else{
-				printk("--> ERROR: LOCK Nº %d sobre MUTEX %s NO_RECURSIVO\n", mutex->n_veces_lock, mutex->nombre);
-				return ERROR_GENERICO;
-			}
-		}
-	}
 	return 0;
 }
 
 /**
-*	Llamada que intenta desbloquearbloquear al sistema. 
-*	Si el mutex ya está bloqueado por otro proceso, el proceso que realiza la operación se bloquea. 
-*	En caso contrario se bloquea el mutex sin bloquear al proceso.
+*	Termina el trabajo del periodo actual de un proceso de tiempo real y lo
+*	bloquea hasta que empiece el siguiente, con el presupuesto completo.
+*	Si ha terminado despues del plazo se cuenta como plazo incumplido y si
+*	el siguiente periodo ya ha empezado no se bloquea.
 */
-int unlock(){
-	unsigned int mutexid = (unsigned int) leer_registro(1);
-	Mutex *mutex = &tabla_mutex[mutexid];
-	printk("-> PROC %d: UNLOCK MUTEX %s\n", p_proc_actual->id, mutex->nombre);
-	
-	int index_mutex_proc = buscar_descriptor_mutex_proc(mutexid);
-	printk("---> TRABAJAMOS CON EL DESCRIPTOR %d del MUTEX %s\n", mutexid, mutex->nombre);
+int esperar_periodo(){
+	BCPptr p_proc = p_proc_actual;
+	int inicio;
 
-	if(index_mutex_proc < 0){
-		printk("--->ERROR: El proceso %d no tiene el mutex %s\n", p_proc_actual->id, mutex->nombre);
-		return ERROR_MUTEX_NO_EXISTE;
+	if(!p_proc->tiempo_real)
+		return ERROR_NO_TIEMPO_REAL;
+
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	// En un periodo largo del reloj sin ticks se pone al dia num_int_reloj
+	ajustar_reloj();
+	if(num_int_reloj > p_proc->plazo_absoluto){
+		printk("--> PROC %d: PLAZO INCUMPLIDO (%d > %d)\n", p_proc->id, num_int_reloj, p_proc->plazo_absoluto);
+		p_proc->plazos_incumplidos++;
 	}
 
-	if(mutex->id_proceso_lock == p_proc_actual->id && mutex->estado == OCUPADO){
-		printk("----> PROC %d: TIENE MUTEX %s OCUPADO Y VA A DESBLOQUEARLO\n", p_proc_actual->id, mutex->nombre);
-		if(mutex->tipo == RECURSIVO){
-			mutex->n_veces_lock--;
-			printk("----> PROC %d: UNLOCK RECURSIVO N %d del MUTEX %s\n", p_proc_actual->id, mutex->n_veces_lock, mutex->nombre);
-			if(mutex->n_veces_lock == 0){
-				printk("----> PROC %d: ULTIMO UNLOCK Y DESBLOQUEA\n", p_proc_actual->id);
-				mutex->estado = LIBRE;
-				mutex->id_proceso_lock = NO_USADO;
-				// Desbloqueamos procesos que estaban bloqueados
-				BCP *p_proc = mutex->procesos_bloqueados.primero;
-				if(p_proc != NULL){
-					printk("----> PROC %d DESBLOQUEA a %d por MUTEX %s\n", p_proc_actual->id, p_proc->id, mutex->nombre);
-					p_proc->estado = LISTO;
-					int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-					eliminar_elem(&mutex->procesos_bloqueados, p_proc);
-					insertar_ultimo(&lista_listos, p_proc);				
-					fijar_nivel_int(nivel_interrupcion_previo);
-				}
-				
-			}
-		} else{
-			// MUTEX NO_RECURSIVO
-			if(mutex->n_veces_lock == 1){
-				printk("----> PROC %d: UNLOCK Y DESBLOQUEA\n", p_proc_actual->id);
-				mutex->n_veces_lock--;
-				mutex->estado = LIBRE;
-				mutex->id_proceso_lock = NO_USADO;
-				// Desbloqueamos procesos que estaban bloqueados
-				BCP *p_proc = mutex->procesos_bloqueados.primero;
-				if(p_proc != NULL){
-					printk("----> PROC %d DESBLOQUEA a %d por MUTEX %s\n", p_proc_actual->id, p_proc->id, mutex->nombre);
-					p_proc->estado = LISTO;
-					int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-					eliminar_elem(&mutex->procesos_bloqueados, p_proc);
-					insertar_ultimo(&lista_listos, p_proc);				
-					fijar_nivel_int(nivel_interrupcion_previo);
-				}
-			}else{
-				printk("--> ERROR: UNLOCK ADICIONAL sobre MUTEX %s NO_RECURSIVO\n", mutex->n_veces_lock, mutex->nombre);
-				return ERROR_GENERICO;
-			}
+	// Datos del siguiente periodo, que se aplican al volver a listos
+	inicio = p_proc->proximo_periodo;
+	p_proc->plazo_absoluto = inicio + p_proc->plazo_relativo;
+	p_proc->proximo_periodo = inicio + p_proc->periodo;
+	p_proc->presupuesto_restante = p_proc->presupuesto;
+
+	if(inicio > num_int_reloj)
+		esperar_plazo(NULL, inicio - num_int_reloj);
+	else {
+		eliminar_listo(p_proc);
+		insertar_listo(p_proc);
+		if(primer_listo() != p_proc){
+			id_proc_a_expulsar = p_proc->id;
+			activar_int_SW();
 		}
-	} else {
-		// Bloquear proceso en la lista de procesos bloqueados por este mutex
-		printk("--> ERROR: UNLOCK sobre MUTEX %s QUE NO TENIA PROC %d NO TENIA LOCKED\n", mutex->nombre, p_proc_actual->id);
-		return ERROR_GENERICO;
 	}
+	fijar_nivel_int(nivel_interrupcion_previo);
+
 	return 0;
 }
 
 /**
-*	Rutina que actualiza la vida de un proceso (Implementacion de Round Robin)
+*	Devuelve los parametros de tiempo real del proceso que la invoca y
+*	cuantos plazos ha incumplido y cuantas veces ha agotado el presupuesto.
+*	Devuelve 0 o un numero negativo si el puntero es nulo.
 */
-void tratamiento_round_robin(){
-	if(p_proc_actual->estado == LISTO){
-		p_proc_actual->vida--;
-		if(p_proc_actual->vida <= 0){
-			printk("--> PROC %d: VIDA = %d. FIN DE RODAJA. SE ACTIVA INT. SW \n", p_proc_actual->id, p_proc_actual->vida);
-			// Si el proceso ha agotado su tiempo de vida, se activa interrupcion SW
-			id_proc_a_expulsar = p_proc_actual->id;
-			activar_int_SW();
-		}
-	}
-	// Proceso bloqueado || nulo no consume su tiempo de vida
+int info_tiempo_real(){
+	struct info_tiempo_real *info = (struct info_tiempo_real *) leer_registro(1);
+
+	if(info == NULL)
+		return ERROR_GENERICO;
+	// Flag para saber que estamos en zona de memoria de proceso usuario
+	zona_mem_proc_usuario = 1;
+	info->periodo = p_proc_actual->tiempo_real ? p_proc_actual->periodo : 0;
+	info->presupuesto = p_proc_actual->tiempo_real ? p_proc_actual->presupuesto : 0;
+	info->plazo = p_proc_actual->tiempo_real ? p_proc_actual->plazo_relativo : 0;
+	info->plazos_incumplidos = p_proc_actual->plazos_incumplidos;
+	info->excesos_presupuesto = p_proc_actual->excesos_presupuesto;
+	zona_mem_proc_usuario = 0;
+	return 0;
 }
 
-/*
-*	Lee caracter del terminal y lo devuelve como resultado
+/**
+*	Fija los tickets (de 1 a TICKETS_MAXIMO) del proceso que la invoca, que
+*	determinan la parte del procesador que recibe en la politica stride.
+*	Con otras politicas solo se guardan. Los hijos los heredan.
+*	Devuelve los tickets anteriores o un numero negativo en caso de error.
 */
-int leer_caracter(){
-	printk("-> PROC %d: LEER_CARACTER\n    BUFFER: %s LENGTH: %d\n", p_proc_actual->id, caracteres.buffer, caracteres.length);
-	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_2);
-	
-	// Si no hay caracteres en el buffer, bloqueamos el proceso
-	while(caracteres.length == 0) {
-		// Si no hay caracteres en el buffer, bloqueamos el proceso
-		BCPptr p_proc = p_proc_actual;
-		p_proc->estado = BLOQUEADO;
-		int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
-		eliminar_elem(&lista_listos, p_proc);
-		insertar_ultimo(&lista_bloq_caracter, p_proc);
-		fijar_nivel_int(nivel_interrupcion_previo);
-		p_proc_actual = planificador();
-		cambio_contexto(&(p_proc->contexto_regs), &(p_proc_actual->contexto_regs));
+int fijar_tickets(){
+	int tickets = (int) leer_registro(1);
+	printk("-> PROC %d: FIJAR TICKETS %d\n", p_proc_actual->id, tickets);
+
+	if(tickets < 1 || tickets > TICKETS_MAXIMO){
+		printk("--->ERROR: El numero de tickets %d no es valido\n", tickets);
+		return ERROR_TICKETS;
 	}
 
-	// Si hay caracteres en el buffer, devolvemos el primero
-	int c = (int) caracteres.buffer[caracteres.puntero_lectura];
-	printk("--> PROC %d: LECTURA CARACTER Nº %d\n", p_proc_actual->id, caracteres_leidos);
-	caracteres.puntero_lectura = (caracteres.puntero_lectura + 1) % TAM_BUF_TERM;
-	printk("---> PROC %d: ACTUALIZACION PUNTERO LECTURA A %d \n", p_proc_actual->id, caracteres.puntero_lectura);
-	caracteres.length--;
-	caracteres_leidos++;
+	// El paso no cambia, por lo que el proceso no se mueve en el monticulo
+	int tickets_anteriores = p_proc_actual->tickets;
+	p_proc_actual->tickets = tickets;
+	p_proc_actual->zancada = ZANCADA_BASE / tickets;
+
+	return tickets_anteriores;
+}
+
+/**
+*	Copia en est las estadisticas del planificador del proceso con el
+*	identificador indicado o, si es -1, las de todo el sistema.
+*	Devuelve 0 o un numero negativo si el proceso no existe o el puntero
+*	es nulo.
+*/
+int estadisticas_planif(){
+	int id = (int) leer_registro(1);
+	struct estadisticas_planif *est = (struct estadisticas_planif *) leer_registro(2);
+	struct estadisticas_planif *orig;
+	BCP *p_proc;
+
+	if(est == NULL)
+		return ERROR_GENERICO;
+	if(id == -1)
+		orig = &estadisticas_sistema;
+	else if((p_proc = buscar_proceso(id)) != NULL)
+		orig = &p_proc->estadisticas;
+	else
+		return ERROR_PROCESO_NO_EXISTE;
+
+	int nivel_interrupcion_previo = fijar_nivel_int(NIVEL_3);
+	// Flag para saber que estamos en zona de memoria de proceso usuario
+	zona_mem_proc_usuario = 1;
+	*est = *orig;
+	zona_mem_proc_usuario = 0;
 	fijar_nivel_int(nivel_interrupcion_previo);
-	return c;
+	return 0;
+}
+
+/**
+*	Fija el tamao de pila (de TAM_PILA_MINIMA a TAM_PILA_MAXIMA, o 0 para
+*	el tamao por defecto) de los procesos que cree el que la invoca. Se
+*	redondea a la potencia de 2 superior. Devuelve el tamao fijado o un
+*	numero negativo en caso de error.
+*/
+int fijar_tam_pila(){
+	int tam = (int) leer_registro(1);
+	printk("-> PROC %d: FIJAR TAMAO DE PILA %d\n", p_proc_actual->id, tam);
+
+	if(tam == 0)
+		tam = TAM_PILA;
+	if(tam < TAM_PILA_MINIMA || tam > TAM_PILA_MAXIMA){
+		printk("--->ERROR: El tamao de pila %d no es valido\n", tam);
+		return ERROR_TAM_PILA;
+	}
+	p_proc_actual->tam_pila_hijos = TAM_PILA_MINIMA << clase_pila(tam);
+	return p_proc_actual->tam_pila_hijos;
+}
 
+/**
+*	Devuelve cuantas pilas se han obtenido de la reserva y cuantas se han
+*	tenido que crear o liberar por no haber o estar llena. Devuelve 0 o un
+*	numero negativo si el puntero es nulo.
+*/
+int info_pilas(){
+	struct info_pilas *info = (struct info_pilas *) leer_registro(1);
+
+	if(info == NULL)
+		return ERROR_GENERICO;
+	// Flag para saber que estamos en zona de memoria de proceso usuario
+	zona_mem_proc_usuario = 1;
+	*info = estadisticas_pilas;
+	zona_mem_proc_usuario = 0;
+	return 0;
 }
 
+/**
+*	Devuelve cuantas imagenes se han obtenido de la cache, cuantas se han
+*	cargado (y el tiempo empleado en ello) y cuantas se han expulsado.
+*	Devuelve 0 o un numero negativo si el puntero es nulo.
+*/
+int info_imagenes(){
+	struct info_imagenes *info = (struct info_imagenes *) leer_registro(1);
+
+	if(info == NULL)
+		return ERROR_GENERICO;
+	// Flag para saber que estamos en zona de memoria de proceso usuario
+	zona_mem_proc_usuario = 1;
+	*info = estadisticas_imagenes;
+	zona_mem_proc_usuario = 0;
+	return 0;
+}
 
 // ----------------------------------------------------
 // Funciones auxiliares
@@ -972,6 +3371,18 @@ int len(char *string){
 	return i;
 }
 
+/**
+*   Funcion auxiliar que calcula el hash FNV-1a de un nombre
+*/
+unsigned int hash_nombre(char *nombre){
+	unsigned int hash = 2166136261U;
+	for(int i = 0; nombre[i] != '\0'; i++){
+		hash ^= (unsigned char) nombre[i];
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
 /**
 *   Funcion auxiliar para comparar si dos string son iguales
 *  	Devuelve 1 si son iguales, 0 en caso contrario
@@ -1019,6 +3430,7 @@ int main(){
 
 	iniciar_cont_int();			/* inicia cont. interr. */
 	iniciar_cont_reloj(TICK);	/* fija frecuencia del reloj */
+	ms_ultima_int = leer_reloj_CMOS();
 	iniciar_cont_teclado();		/* inici cont. teclado */
 
 	iniciar_tabla_proc();		/* inicia BCPs de tabla de procesos */
@@ -42,7 +42,7 @@ int main(){
 	/* libera un descriptor de mutex (m1) */
 	cerrar_mutex(desc);
 
-	/* Agotado num mutex del sistema. Debe bloquearse */
+	/* Agotado num mutex del sistema (arrancar con MAX_MUTEX=16). Debe bloquearse */
 	if (crear_mutex("m17", 0)<0)
 		printf("error creando m17. NO DEBE SALIR\n");
 	/* se desbloquear cuando se elimine m1 */
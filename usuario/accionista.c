@@ -0,0 +1,38 @@
+/*
+ * usuario/accionista.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que forma parte de la prueba de stride
+ * (prueba_stride): gasta CPU durante VENTANA ticks reales e informa del
+ * porcentaje del procesador que ha recibido. Sus tickets los hereda del
+ * creador.
+ */
+
+#include "servicios.h"
+
+#define VENTANA 500	/* en ticks */
+
+int main(){
+	int id, tickets, t0, t1;
+	struct tiempos_ejec ini, fin;
+
+	id=obtener_id_pr();
+	/* consulta sus tickets dejandolos como estaban */
+	tickets=fijar_tickets(1);
+	fijar_tickets(tickets);
+
+	t0=tiempos_proceso(&ini);
+	do
+		t1=tiempos_proceso(&fin);
+	while (t1-t0<VENTANA);
+
+	printf("accionista (%d): %d tickets, %d%% del procesador\n", id, tickets,
+		(fin.usuario+fin.sistema-ini.usuario-ini.sistema)*100/(t1-t0));
+	return 0;
+}
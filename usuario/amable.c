@@ -0,0 +1,36 @@
+/*
+ * usuario/amable.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que baja su peso (nice 10) y "gasta CPU". Informa
+ * de los ticks reales que tarda y de los que ha ejecutado.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 1000000000	/* ponga las que considere oportuno */
+
+int main(){
+	int i, tot, id, t0, t1;
+	int j=5;
+	struct tiempos_ejec tiempos;
+
+	id=obtener_id_pr();
+	fijar_nice(10);
+	printf("amable (%d): comienza con nice 10\n", id);
+
+	t0=tiempos_proceso(0);
+	for (i=0; i<TOT_ITER; i++)
+		tot=j*i;
+	t1=tiempos_proceso(&tiempos);
+	printf("amable (%d): termina. Real %d Usuario %d\n", id, t1-t0,
+		tiempos.usuario);
+	tot--;
+	return 0;
+}
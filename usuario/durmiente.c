@@ -0,0 +1,19 @@
+/*
+ * usuario/durmiente.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que duerme un segundo y termina sin escribir nada.
+ */
+
+#include "servicios.h"
+
+int main(){
+	dormir(1);
+	return 0;
+}
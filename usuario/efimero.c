@@ -0,0 +1,21 @@
+/*
+ * usuario/efimero.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que termina nada más empezar, tras consultar su
+ * identificador.
+ */
+
+#include "servicios.h"
+
+int main(){
+	if (obtener_id_pr() < 0)
+		printf("efimero: identificador incorrecto\n");
+	return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * usuario/esperador.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que forma parte de la prueba de las llamadas con
+ * plazo (prueba_plazos).
+ */
+
+#include "servicios.h"
+
+int main(){
+	int desc, t0, t1, res;
+
+	printf("esperador comienza\n");
+
+	if ((desc=abrir_mutex("mp"))<0)
+		printf("error abriendo mp. NO DEBE APARECER\n");
+
+	res=trylock(desc);
+	printf("trylock sobre mp ocupado: %d (debe ser %d)\n", res,
+		ERROR_MUTEX_OCUPADO);
+
+	t0=tiempos_proceso(0);
+	res=lock_timeout(desc, 300);
+	t1=tiempos_proceso(0);
+	printf("lock_timeout(300 ms): %d (debe ser %d) tras %d ticks\n", res,
+		ERROR_PLAZO_LOCK, t1-t0);
+
+	t0=tiempos_proceso(0);
+	res=lock_timeout(desc, 5000);
+	t1=tiempos_proceso(0);
+	printf("lock_timeout(5000 ms): %d (debe ser 0) tras %d ticks\n", res,
+		t1-t0);
+
+	if (unlock(desc)<0)
+		printf("error en unlock de mutex. NO DEBE APARECER\n");
+
+	res=leer_caracter_no_bloq();
+	printf("leer_caracter_no_bloq: %d (debe ser %d)\n", res,
+		ERROR_SIN_CARACTERES);
+
+	t0=tiempos_proceso(0);
+	res=leer_caracter_timeout(200);
+	t1=tiempos_proceso(0);
+	printf("leer_caracter_timeout(200 ms): %d (debe ser %d) tras %d ticks\n",
+		res, ERROR_PLAZO_LECTURA, t1-t0);
+
+	printf("esperador termina\n");
+	return 0;
+}
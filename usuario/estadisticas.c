@@ -0,0 +1,51 @@
+/*
+ * usuario/estadisticas.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que muestra las estadísticas del planificador de
+ * todo el sistema y de los procesos existentes.
+ */
+
+#include "servicios.h"
+
+#define MAX_ID 32	/* se consultan los identificadores de la primera
+			   generación de las MAX_ID primeras entradas */
+
+static void imp_estadisticas(struct estadisticas_planif *est){
+	int i;
+
+	printf("  cambios de contexto: voluntarios %d involuntarios %d\n",
+		est->cambios_voluntarios, est->cambios_involuntarios);
+	printf("  latencia (ms):");
+	for (i=0; i<NUM_INTERVALOS_LATENCIA; i++)
+		if (est->latencia[i])
+			printf(" <%d:%d", 1<<i, est->latencia[i]);
+	printf("\n  long. cola de listos:");
+	for (i=0; i<NUM_LONG_COLA; i++)
+		if (est->long_cola[i])
+			printf(" %d:%d", i, est->long_cola[i]);
+	printf("\n");
+}
+
+int main(){
+	int id;
+	struct estadisticas_planif est;
+
+	if (estadisticas_planif(-1, &est)==0){
+		printf("estadisticas: sistema (cola de listos en ticks)\n");
+		imp_estadisticas(&est);
+	}
+
+	for (id=0; id<MAX_ID; id++)
+		if (estadisticas_planif(id, &est)==0){
+			printf("estadisticas: proceso %d (cola de listos al despertar)\n", id);
+			imp_estadisticas(&est);
+		}
+	return 0;
+}
@@ -0,0 +1,26 @@
+/*
+ * usuario/etapa.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que ejecuta prueba_ejecutar con la llamada ejecutar:
+ * muestra su identificador, sus tiempos y el descriptor del mutex que
+ * abrió el programa anterior.
+ */
+
+#include "servicios.h"
+
+int main(){
+	struct tiempos_ejec t;
+
+	tiempos_proceso(&t);
+	printf("etapa (%d): tiempo de usuario %d (NO DEBE SER 0), mutex %d (DEBE SER EL MISMO)\n",
+		obtener_id_pr(), t.usuario, abrir_mutex("etapa"));
+	printf("etapa (%d): termina\n", obtener_id_pr());
+	return 0;
+}
@@ -0,0 +1,25 @@
+/*
+ * usuario/hijo_estado.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que duerme un tiempo que depende de su identificador
+ * y termina con el valor identificador % 1000.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int id = obtener_id_pr();
+
+	dormir_ms((id % 4) * 100);
+	printf("hijo_estado (%d): termina con %d\n", id, id % 1000);
+	terminar_con_estado(id % 1000);
+	printf("hijo_estado (%d): ERROR sigue tras terminar\n", id);
+	return 0;
+}
@@ -28,28 +28,169 @@ struct tiempos_ejec {
     int sistema;
 };
 
+// Estructura para obtener los parámetros de tiempo real y su cumplimiento
+struct info_tiempo_real {
+    int periodo;
+    int presupuesto;
+    int plazo;
+    int plazos_incumplidos;
+    int excesos_presupuesto;
+};
+
+// Estructura para obtener las estadísticas del planificador: histograma de
+// latencias (en ms: el intervalo 0 cuenta las menores de 1 ms, el i las de
+// [2^(i-1), 2^i) y el último las mayores), histograma de la longitud de la
+// cola de listos y cambios de contexto
+#define NUM_INTERVALOS_LATENCIA 12
+#define NUM_LONG_COLA 16
+struct estadisticas_planif {
+    int cambios_voluntarios;
+    int cambios_involuntarios;
+    int latencia[NUM_INTERVALOS_LATENCIA];
+    int long_cola[NUM_LONG_COLA];
+};
+
+// Estructura para obtener el uso de la reserva de pilas del sistema
+struct info_pilas {
+    int aciertos;
+    int fallos;
+    int descartadas;
+    int en_reserva;
+};
+
+// Estructura para obtener el uso de la cache de imágenes de programas del
+// sistema y el tiempo empleado en cargarlas (en ms)
+struct info_imagenes {
+    int aciertos;
+    int fallos;
+    int expulsiones;
+    int ms_carga;
+};
+
+// Estructura para obtener la rodaja del proceso y su uso
+struct info_rodaja {
+    int rodaja;
+    int adaptativa;
+    int rodajas_agotadas;
+    int bloqueos_tempranos;
+};
+
 /**
 *	Constantes para la especificación del tipo de mutex
 */
 #define NO_RECURSIVO 0 
 #define RECURSIVO 1
 
+/**
+*	Constantes para la especificación de la preferencia de un rwlock
+*/
+#define PREFERENCIA_LECTORES 0
+#define PREFERENCIA_ESCRITORES 1
+
+/**
+*	Constantes para la especificación de la prioridad
+*/
+#define PRIORIDAD_MINIMA 0
+#define PRIORIDAD_MAXIMA 7
+#define PRIORIDAD_POR_DEFECTO 4
+
+/**
+*	Constantes para la especificación del valor nice (planificación CFS)
+*/
+#define NICE_MINIMO -20
+#define NICE_MAXIMO 19
+
+/**
+*	Constantes para la especificación de los tickets (planificación stride)
+*/
+#define TICKETS_MAXIMO 1000
+#define TICKETS_POR_DEFECTO 100
+
+/**
+*	Constantes para la especificación del tamaño de pila de los procesos
+*	creados (se redondea a la potencia de 2 superior)
+*/
+#define TAM_PILA_MINIMA 8192
+#define TAM_PILA_MAXIMA 65536
+
+/**
+*	Códigos de error devueltos por las llamadas
+*/
+#define ERROR_MUTEX_OCUPADO -16
+#define ERROR_PLAZO_LOCK -17
+#define ERROR_PLAZO_LECTURA -18
+#define ERROR_SIN_CARACTERES -19
+#define ERROR_RODAJA -20
+#define ERROR_NICE -21
+#define ERROR_PARAMETROS_TR -22
+#define ERROR_ADMISION_TR -23
+#define ERROR_NO_TIEMPO_REAL -24
+#define ERROR_TICKETS -25
+#define ERROR_PROCESO_NO_EXISTE -26
+#define ERROR_TAM_PILA -27
+#define ERROR_NO_HIJO -28
+#define ERROR_PLAZO_CREAR -29
+#define ERROR_TIPO_MUTEX -30
+#define ERROR_SEM_OCUPADO -31
+
+// Valor de terminación de un proceso abortado por una excepción
+#define ESTADO_EXCEPCION -1
+
 /* Funcion de biblioteca */
 int escribirf(const char *formato, ...);
 
 /* Llamadas al sistema proporcionadas */
 int crear_proceso(char *prog);
+int crear_procesos(char *prog, unsigned int n, int *pids);
+int crear_proceso_bloq(char *prog);
+int crear_proceso_timeout(char *prog, unsigned int milisegs);
 int terminar_proceso();
+int terminar_con_estado(int estado);
+int esperar_proceso(int pid, int *estado);
+int esperar_cualquier_hijo(int *estado);
+int crear_hilo(void (*funcion)(void *), void *arg);
+int terminar_hilo();
+int ejecutar(char *prog);
 int escribir(char *texto, unsigned int longi);
 int obtener_id_pr();
 int dormir(unsigned int segundos);
+int dormir_ms(unsigned int milisegs);
+int dormir_hasta(int tick);
 int tiempos_proceso(struct tiempos_ejec *t_ejec);
 int crear_mutex(char *nombre, int tipo);
 int abrir_mutex(char *nombre);
 int cerrar_mutex(unsigned int mutexid);
 int lock(unsigned int mutexid);
+int trylock(unsigned int mutexid);
+int lock_timeout(unsigned int mutexid, unsigned int milisegs);
 int unlock(unsigned int mutexid);
+int crear_rwlock(char *nombre, int preferencia);
+int abrir_rwlock(char *nombre);
+int cerrar_rwlock(unsigned int rwlockid);
+int rdlock(unsigned int rwlockid);
+int wrlock(unsigned int rwlockid);
+int rwunlock(unsigned int rwlockid);
+int crear_sem(char *nombre, int valor);
+int abrir_sem(char *nombre);
+int cerrar_sem(unsigned int semid);
+int sem_wait(unsigned int semid);
+int sem_trywait(unsigned int semid);
+int sem_post(unsigned int semid);
 int leer_caracter();
+int leer_caracter_timeout(unsigned int milisegs);
+int leer_caracter_no_bloq();
+int fijar_prioridad(unsigned int prioridad);
+int fijar_rodaja(unsigned int ticks, int adaptativa);
+int info_rodaja(struct info_rodaja *info);
+int fijar_nice(int nice);
+int fijar_tiempo_real(unsigned int periodo, unsigned int presupuesto, unsigned int plazo);
+int esperar_periodo();
+int info_tiempo_real(struct info_tiempo_real *info);
+int fijar_tickets(unsigned int tickets);
+int estadisticas_planif(int id, struct estadisticas_planif *est);
+int fijar_tam_pila(unsigned int tam);
+int info_pilas(struct info_pilas *info);
+int info_imagenes(struct info_imagenes *info);
 
 #endif /* SERVICIOS_H */
 
@@ -64,7 +64,7 @@ ALGO COMENTE ESTA PARTE Y DESCOMENTE LA PRUEBA CORRESPONDIENTE */
 		printf("Error creando prueba_tiempos\n");
 */
 
-/* PRIMERA PRUEBA DE MUTEX
+/* PRIMERA PRUEBA DE MUTEX (arrancar con MAX_MUTEX=16)
 	if (crear_proceso("prueba_mutex1")<0)
 		printf("Error creando prueba_mutex1\n");
 */
@@ -89,6 +89,131 @@ ALGO COMENTE ESTA PARTE Y DESCOMENTE LA PRUEBA CORRESPONDIENTE */
 		printf("Error creando prueba_term\n");
 */
 
+/* PRUEBA DE PRIORIDADES
+	if (crear_proceso("prueba_prioridad")<0)
+		printf("Error creando prueba_prioridad\n");
+*/
+
+/* PRUEBA DE MLFQ (COMPILAR EL SISTEMA CON make PLANIF=PLANIF_MLFQ)
+	if (crear_proceso("prueba_mlfq")<0)
+		printf("Error creando prueba_mlfq\n");
+*/
+
+/* PRUEBA DE LA RUEDA DE PLAZOS
+	if (crear_proceso("prueba_rueda")<0)
+		printf("Error creando prueba_rueda\n");
+*/
+
+/* PRUEBA DE DORMIR_MS Y DORMIR_HASTA
+	if (crear_proceso("prueba_dormir_ms")<0)
+		printf("Error creando prueba_dormir_ms\n");
+*/
+
+/* PRUEBA DE TRYLOCK, LOCK_TIMEOUT Y LECTURAS CON PLAZO
+	if (crear_proceso("prueba_plazos")<0)
+		printf("Error creando prueba_plazos\n");
+*/
+
+/* PRUEBA DE LA RODAJA ADAPTATIVA
+	if (crear_proceso("prueba_rodaja")<0)
+		printf("Error creando prueba_rodaja\n");
+*/
+
+/* PRUEBA DE CFS (COMPILAR EL SISTEMA CON make PLANIF=PLANIF_CFS)
+	if (crear_proceso("prueba_cfs")<0)
+		printf("Error creando prueba_cfs\n");
+*/
+
+/* PRUEBA DE TIEMPO REAL EDF
+	if (crear_proceso("prueba_edf")<0)
+		printf("Error creando prueba_edf\n");
+*/
+
+/* PRUEBA DE STRIDE (COMPILAR EL SISTEMA CON make PLANIF=PLANIF_STRIDE)
+	if (crear_proceso("prueba_stride")<0)
+		printf("Error creando prueba_stride\n");
+*/
+
+/* PRUEBA DE LAS ESTADISTICAS DEL PLANIFICADOR
+	if (crear_proceso("prueba_estadisticas")<0)
+		printf("Error creando prueba_estadisticas\n");
+*/
+
+/* PRUEBA DE LA TABLA DE PROCESOS
+	if (crear_proceso("prueba_procesos")<0)
+		printf("Error creando prueba_procesos\n");
+*/
+
+/* PRUEBA DE LA RESERVA DE PILAS
+	if (crear_proceso("prueba_pilas")<0)
+		printf("Error creando prueba_pilas\n");
+*/
+
+/* PRUEBA DE LA CACHE DE IMAGENES
+	if (crear_proceso("prueba_imagenes")<0)
+		printf("Error creando prueba_imagenes\n");
+*/
+
+/* PRUEBA DE LA CREACION DE VARIOS PROCESOS CON UNA LLAMADA
+	if (crear_proceso("prueba_crear_procesos")<0)
+		printf("Error creando prueba_crear_procesos\n");
+*/
+
+/* PRUEBA DE LA ESPERA POR LA TERMINACION DE LOS HIJOS
+	if (crear_proceso("prueba_esperar")<0)
+		printf("Error creando prueba_esperar\n");
+*/
+
+/* PRUEBA DE LOS HILOS
+	if (crear_proceso("prueba_hilos")<0)
+		printf("Error creando prueba_hilos\n");
+*/
+
+/* PRUEBA DE LA LLAMADA EJECUTAR
+	if (crear_proceso("prueba_ejecutar")<0)
+		printf("Error creando prueba_ejecutar\n");
+*/
+
+/* PRUEBA DE LA CREACION DE PROCESOS CON LA TABLA DE PROCESOS LLENA
+	if (crear_proceso("prueba_tabla_llena")<0)
+		printf("Error creando prueba_tabla_llena\n");
+*/
+
+/* PRUEBA DE LA TABLA DE MUTEX AMPLIABLE
+	if (crear_proceso("prueba_registro_mutex")<0)
+		printf("Error creando prueba_registro_mutex\n");
+*/
+
+/* PRUEBA DEL LOCK Y UNLOCK SIN LLAMADA AL SISTEMA SIN COMPETENCIA
+	if (crear_proceso("prueba_futex")<0)
+		printf("Error creando prueba_futex\n");
+*/
+
+/* PRUEBA DE COMPETENCIA POR UN MUTEX CON Y SIN TRASPASO (make TRASPASO_MUTEX=0)
+	if (crear_proceso("prueba_traspaso")<0)
+		printf("Error creando prueba_traspaso\n");
+*/
+
+/* PRUEBA DE LA HERENCIA DE PRIORIDAD EN CADENAS DE MUTEX
+	if (crear_proceso("prueba_herencia")<0)
+		printf("Error creando prueba_herencia\n");
+*/
+
+/* PRUEBA DE LOS CERROJOS DE LECTORES Y ESCRITORES
+	if (crear_proceso("prueba_rwlock")<0)
+		printf("Error creando prueba_rwlock\n");
+*/
+
+/* PRUEBA DE LOS SEMAFOROS
+	if (crear_proceso("prueba_sem")<0)
+		printf("Error creando prueba_sem\n");
+*/
+
+/* PRUEBA DE LOS TIEMPOS DE PROCESADOR CON EL RELOJ SIN TICKS
+	if (crear_proceso("prueba_sin_ticks")<0)
+		printf("Error creando prueba_sin_ticks\n");
+*/
+
 	printf("init: termina\n");
 	return 0; 
 }
@@ -0,0 +1,36 @@
+/*
+ * usuario/interactivo.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que duerme repetidamente y mide cuántos ticks
+ * tarda en volver a ejecutar desde que vence su plazo.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 5
+#define TICKS_POR_SEGUNDO 100
+
+int main(){
+	int i, id, t0, t1;
+
+	id=obtener_id_pr();
+	printf("interactivo (%d): comienza\n", id);
+
+	for (i=0; i<TOT_ITER; i++) {
+		t0=tiempos_proceso(0);
+		dormir(1);
+		t1=tiempos_proceso(0);
+		printf("interactivo (%d): retraso al despertar %d ticks\n",
+			id, t1-t0-TICKS_POR_SEGUNDO);
+	}
+
+	printf("interactivo (%d): termina\n", id);
+	return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * usuario/intruso.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba_futex crea dos veces con crear_procesos,
+ * de modo que ambos procesos comparten la imagen y las palabras que guarda
+ * la biblioteca. El primero crea el mutex y lo usa; el segundo, que no lo
+ * ha abierto, intenta usarlo con el mismo descriptor mientras el primero
+ * lo tiene abierto y después de que lo cierre al terminar.
+ */
+
+#include "servicios.h"
+
+static int compartido = -1;
+
+int main(){
+	int m, err;
+
+	if ((m = crear_mutex("ajeno", NO_RECURSIVO)) >= 0){
+		compartido = m;
+		lock(m);
+		unlock(m);
+		dormir_ms(200);
+		return 0;	/* el cierre implicito invalida su palabra */
+	}
+	dormir_ms(100);
+	err = lock(compartido);
+	printf("intruso (%d): lock de un mutex que no ha abierto %d, unlock %d (DEBEN SER ERROR)\n",
+		obtener_id_pr(), err, unlock(compartido));
+	dormir_ms(300);
+	printf("intruso (%d): lock tras cerrarlo el que lo creo %d (DEBE SER ERROR)\n",
+		obtener_id_pr(), lock(compartido));
+	return 0;
+}
@@ -38,8 +38,50 @@ int crear_proceso(char *prog){
 	return llamsis(CREAR_PROCESO, 1, (long)prog);
 }
 
+int crear_proceso_bloq(char *prog){
+	return llamsis(CREAR_PROCESO_BLOQ, 1, (long)prog);
+}
+
+int crear_proceso_timeout(char *prog, unsigned int milisegs){
+	return llamsis(CREAR_PROCESO_TIMEOUT, 2, (long)prog, (long)milisegs);
+}
+
 int terminar_proceso(){
-	return llamsis(TERMINAR_PROCESO, 0);
+	return llamsis(TERMINAR_PROCESO, 1, 0);
+}
+
+int terminar_con_estado(int estado){
+	return llamsis(TERMINAR_PROCESO, 1, (long)estado);
+}
+
+int esperar_proceso(int pid, int *estado){
+	return llamsis(ESPERAR_PROCESO, 2, (long)pid, (long)estado);
+}
+
+int esperar_cualquier_hijo(int *estado){
+	return llamsis(ESPERAR_PROCESO, 2, -1L, (long)estado);
+}
+
+/* Punto de arranque de los hilos: obtiene su funcion y su argumento */
+static void lanzadera_hilo(){
+	void (*funcion)(void *);
+	void *arg;
+
+	if (llamsis(DATOS_HILO, 2, (long)&funcion, (long)&arg) == 0)
+		funcion(arg);
+	terminar_hilo();
+}
+
+int crear_hilo(void (*funcion)(void *), void *arg){
+	return llamsis(CREAR_HILO, 3, (long)lanzadera_hilo, (long)funcion, (long)arg);
+}
+
+int terminar_hilo(){
+	return llamsis(TERMINAR_PROCESO, 1, 0);
+}
+
+int ejecutar(char *prog){
+	return llamsis(EJECUTAR, 1, (long)prog);
 }
 
 int escribir(char *texto, unsigned int longi){
@@ -54,6 +96,14 @@ int dormir(unsigned int segundos){
    return llamsis(DORMIR, 1, segundos);
 }
 
+int dormir_ms(unsigned int milisegs){
+   return llamsis(DORMIR_MS, 1, milisegs);
+}
+
+int dormir_hasta(int tick){
+   return llamsis(DORMIR_HASTA, 1, tick);
+}
+
 int tiempos_proceso(struct tiempos_ejec *t_ejec){
    return llamsis(TIEMPOS_PROCESO, 1, (long) t_ejec);
 }
@@ -66,18 +116,267 @@ int abrir_mutex(char *nombre){
    return llamsis(ABRIR_MUTEX, 1, (long) nombre);
 }
 
+/*
+ * Palabras de los mutex ya usados, indexadas por el descriptor y el
+ * proceso modulo TAM_CACHE_MUTEX. La biblioteca es comun a todos los
+ * procesos e hilos que ejecutan el programa, por lo que cada entrada
+ * guarda el proceso que abrio el mutex y la generacion de la palabra al
+ * obtenerla: solo se usa sin llamar al nucleo si es del proceso en
+ * ejecucion y ningun proceso ha cerrado el mutex desde entonces. Como
+ * otro proceso puede expulsar al que esta rellenando una entrada, version
+ * es impar mientras se escribe y cambia con cada escritura, y quien la
+ * lee la descarta si no coincide antes y despues de leerla. lock, trylock,
+ * lock_timeout y unlock operan sobre las palabras con operaciones
+ * atomicas y solo hacen la llamada al sistema si hay competencia, si el
+ * descriptor no es valido o si hay que devolver un error.
+ */
+#define TAM_CACHE_MUTEX 16
+
+static struct {
+	unsigned int version;
+	int proceso;
+	unsigned int mutexid;
+	int generacion;
+	palabra_mutex *palabra;
+} cache_mutex[TAM_CACHE_MUTEX];
+
+static int *id_en_ejecucion;
+
+static palabra_mutex *buscar_palabra(int i, int proceso, unsigned int mutexid){
+	unsigned int version = __atomic_load_n(&cache_mutex[i].version, __ATOMIC_ACQUIRE);
+	palabra_mutex *palabra = cache_mutex[i].palabra;
+
+	if (version % 2 || palabra == 0 || cache_mutex[i].proceso != proceso ||
+			cache_mutex[i].mutexid != mutexid ||
+			cache_mutex[i].generacion != palabra->generacion)
+		return 0;
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	if (__atomic_load_n(&cache_mutex[i].version, __ATOMIC_RELAXED) != version)
+		return 0;
+	return palabra;
+}
+
+static void guardar_palabra(int i, int proceso, unsigned int mutexid,
+		palabra_mutex *palabra){
+	unsigned int version = cache_mutex[i].version;
+
+	/* Si otro la esta escribiendo, no se guarda */
+	if (version % 2 || !__atomic_compare_exchange_n(&cache_mutex[i].version,
+			&version, version + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		return;
+	cache_mutex[i].proceso = proceso;
+	cache_mutex[i].mutexid = mutexid;
+	cache_mutex[i].generacion = palabra->generacion;
+	cache_mutex[i].palabra = palabra;
+	__atomic_store_n(&cache_mutex[i].version, version + 2, __ATOMIC_RELEASE);
+}
+
+static palabra_mutex *obtener_palabra(unsigned int mutexid){
+	palabra_mutex *palabra;
+	int proceso;
+
+	if (id_en_ejecucion != 0){
+		proceso = *id_en_ejecucion;
+		palabra = buscar_palabra((mutexid + proceso) % TAM_CACHE_MUTEX,
+			proceso, mutexid);
+		if (palabra != 0)
+			return palabra;
+	}
+	if (llamsis(DATOS_MUTEX, 3, (long)mutexid, (long)&palabra,
+			(long)&id_en_ejecucion) < 0)
+		return 0;
+	proceso = *id_en_ejecucion;
+	guardar_palabra((mutexid + proceso) % TAM_CACHE_MUTEX, proceso,
+		mutexid, palabra);
+	return palabra;
+}
+
+/*
+ * Devuelve 1 si obtiene el mutex sin entrar al nucleo. El compare-and-swap
+ * deja en cerrojo su identificador, de modo que el nucleo sabe siempre
+ * quien lo tiene aunque lo expulse antes de anotar n_veces.
+ */
+static int lock_rapido(unsigned int mutexid){
+	palabra_mutex *palabra = obtener_palabra(mutexid);
+	int libre = CERROJO_LIBRE;
+
+	if (palabra == 0)
+		return 0;
+	if (PROPIETARIO(palabra->cerrojo) == *id_en_ejecucion){
+		if (palabra->tipo != RECURSIVO)
+			return 0;	/* el nucleo devuelve el error */
+		palabra->n_veces++;
+		return 1;
+	}
+	if (!__atomic_compare_exchange_n(&palabra->cerrojo, &libre,
+			CERROJO_DE(*id_en_ejecucion), 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		return 0;
+	palabra->n_veces = 1;
+	return 1;
+}
+
+/* Devuelve 1 si libera el mutex sin entrar al nucleo */
+static int unlock_rapido(unsigned int mutexid){
+	palabra_mutex *palabra = obtener_palabra(mutexid);
+	int propio;
+
+	if (palabra == 0 || PROPIETARIO(palabra->cerrojo) != *id_en_ejecucion)
+		return 0;
+	if (palabra->n_veces > 1){
+		palabra->n_veces--;
+		return 1;
+	}
+	propio = CERROJO_DE(*id_en_ejecucion);
+	palabra->n_veces = 0;
+	if (__atomic_compare_exchange_n(&palabra->cerrojo, &propio,
+			CERROJO_LIBRE, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		return 1;
+	/* Hay procesos esperando: lo libera el nucleo despertando a uno */
+	palabra->n_veces = 1;
+	return 0;
+}
+
 int cerrar_mutex(unsigned int mutexid){
    return llamsis(CERRAR_MUTEX, 1, mutexid);
 }
 
 int lock(unsigned int mutexid){
+   if (lock_rapido(mutexid))
+      return 0;
    return llamsis(LOCK, 1, mutexid);
 }
 
+int trylock(unsigned int mutexid){
+   if (lock_rapido(mutexid))
+      return 0;
+   return llamsis(TRYLOCK, 1, mutexid);
+}
+
+int lock_timeout(unsigned int mutexid, unsigned int milisegs){
+   if (lock_rapido(mutexid))
+      return 0;
+   return llamsis(LOCK_TIMEOUT, 2, mutexid, milisegs);
+}
+
 int unlock(unsigned int mutexid){
+   if (unlock_rapido(mutexid))
+      return 0;
    return llamsis(UNLOCK, 1, mutexid);
 }
 
+int crear_rwlock(char *nombre, int preferencia){
+   return llamsis(CREAR_RWLOCK, 2, nombre, preferencia);
+}
+
+int abrir_rwlock(char *nombre){
+   return llamsis(ABRIR_RWLOCK, 1, nombre);
+}
+
+/* Los rwlock comparten los descriptores y el cierre con los mutex */
+int cerrar_rwlock(unsigned int rwlockid){
+   return cerrar_mutex(rwlockid);
+}
+
+int rdlock(unsigned int rwlockid){
+   return llamsis(RDLOCK, 1, rwlockid);
+}
+
+int wrlock(unsigned int rwlockid){
+   return llamsis(WRLOCK, 1, rwlockid);
+}
+
+int rwunlock(unsigned int rwlockid){
+   return llamsis(RWUNLOCK, 1, rwlockid);
+}
+
+int crear_sem(char *nombre, int valor){
+   return llamsis(CREAR_SEM, 2, nombre, valor);
+}
+
+int abrir_sem(char *nombre){
+   return llamsis(ABRIR_SEM, 1, nombre);
+}
+
+int cerrar_sem(unsigned int semid){
+   return cerrar_mutex(semid);
+}
+
+/*
+ * Ocultas para que el programa, que se carga con dlopen, las enlace con
+ * estas y no con las de la biblioteca de C que usa el nucleo
+ */
+__attribute__((visibility("hidden"))) int sem_wait(unsigned int semid){
+   return llamsis(SEM_WAIT, 1, semid);
+}
+
+__attribute__((visibility("hidden"))) int sem_trywait(unsigned int semid){
+   return llamsis(SEM_TRYWAIT, 1, semid);
+}
+
+__attribute__((visibility("hidden"))) int sem_post(unsigned int semid){
+   return llamsis(SEM_POST, 1, semid);
+}
+
 int leer_caracter(){
    return llamsis(LEER_CARACTER, 0);
 }
+
+int leer_caracter_timeout(unsigned int milisegs){
+   return llamsis(LEER_CARACTER_TIMEOUT, 1, milisegs);
+}
+
+int leer_caracter_no_bloq(){
+   return llamsis(LEER_CARACTER_NO_BLOQ, 0);
+}
+
+int fijar_prioridad(unsigned int prioridad){
+   return llamsis(FIJAR_PRIORIDAD, 1, prioridad);
+}
+
+int fijar_rodaja(unsigned int ticks, int adaptativa){
+   return llamsis(FIJAR_RODAJA, 2, ticks, adaptativa);
+}
+
+int info_rodaja(struct info_rodaja *info){
+   return llamsis(INFO_RODAJA, 1, info);
+}
+
+int fijar_nice(int nice){
+   return llamsis(FIJAR_NICE, 1, nice);
+}
+
+int fijar_tiempo_real(unsigned int periodo, unsigned int presupuesto, unsigned int plazo){
+   return llamsis(FIJAR_TIEMPO_REAL, 3, periodo, presupuesto, plazo);
+}
+
+int esperar_periodo(){
+   return llamsis(ESPERAR_PERIODO, 0);
+}
+
+int info_tiempo_real(struct info_tiempo_real *info){
+   return llamsis(INFO_TIEMPO_REAL, 1, info);
+}
+
+int fijar_tickets(unsigned int tickets){
+   return llamsis(FIJAR_TICKETS, 1, tickets);
+}
+
+int estadisticas_planif(int id, struct estadisticas_planif *est){
+   return llamsis(ESTADISTICAS_PLANIF, 2, id, est);
+}
+
+int fijar_tam_pila(unsigned int tam){
+   return llamsis(FIJAR_TAM_PILA, 1, tam);
+}
+
+int info_pilas(struct info_pilas *info){
+   return llamsis(INFO_PILAS, 1, info);
+}
+
+int info_imagenes(struct info_imagenes *info){
+   return llamsis(INFO_IMAGENES, 1, info);
+}
+
+int crear_procesos(char *prog, unsigned int n, int *pids){
+   return llamsis(CREAR_PROCESOS, 3, prog, n, pids);
+}
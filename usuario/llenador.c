@@ -0,0 +1,25 @@
+/*
+ * usuario/llenador.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que llena la tabla de procesos con procesos
+ * durmiente y termina, dejándolos sin padre para que sus entradas se
+ * liberen al terminar.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int n = 0;
+
+	while (crear_proceso("durmiente") == 0)
+		n++;
+	printf("llenador: tabla de procesos llena con %d durmiente\n", n);
+	return 0;
+}
@@ -0,0 +1,39 @@
+/*
+ * usuario/poseedor.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que crea NUM_MUT_PROC mutex con nombres derivados
+ * de su identificador, los mantiene abiertos un segundo y termina.
+ */
+
+#include "servicios.h"
+
+#define NUM_MUT_PROC 4
+
+int main(){
+	char nombre[9];
+	int id = obtener_id_pr() & 0xFFFF;
+
+	for (int i=0; i<NUM_MUT_PROC; i++){
+		/* nombre p<id><i>, como mucho 8 caracteres */
+		int n = id*NUM_MUT_PROC + i, j = 7;
+		nombre[8] = '\0';
+		do {
+			nombre[j--] = '0' + n%10;
+			n /= 10;
+		} while (n > 0);
+		nombre[j] = 'p';
+		if (crear_mutex(&nombre[j], NO_RECURSIVO)<0)
+			printf("poseedor %d: error creando %s. NO DEBE SALIR\n", id, &nombre[j]);
+	}
+	dormir(1);
+
+	/* cierre implícito de mutex */
+	return 0;
+}
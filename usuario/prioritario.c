@@ -0,0 +1,31 @@
+/*
+ * usuario/prioritario.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que sube su prioridad al máximo y "gasta CPU".
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 200000000	/* ponga las que considere oportuno */
+
+int main(){
+	int i, tot, id;
+	int j=5;
+
+	id=obtener_id_pr();
+	printf("prioritario (%d): comienza con prioridad %d\n", id,
+		fijar_prioridad(PRIORIDAD_MAXIMA));
+
+	for (i=0; i<TOT_ITER; i++)
+		tot=j*i;
+	printf("prioritario (%d): termina. DEBE TERMINAR ANTES QUE LOS simplon\n", id);
+	tot--;
+	return 0;
+}
@@ -0,0 +1,43 @@
+/*
+ * usuario/prueba_cfs.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la política CFS
+ * (requiere compilar el sistema con "make PLANIF=PLANIF_CFS"): compite
+ * con un proceso amable (nice 10) gastando el mismo tiempo de CPU. Con
+ * CFS debe recibir en torno al 90% del procesador y terminar mucho antes;
+ * con Round Robin ambos reciben la mitad.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 1000000000	/* ponga las que considere oportuno */
+
+int main(){
+	int i, tot, t0, t1;
+	int j=5;
+	struct tiempos_ejec tiempos;
+
+	printf("prueba_cfs: comienza\n");
+
+	if (fijar_nice(NICE_MAXIMO+1)!=ERROR_NICE)
+		printf("fijar_nice(20) deberia fallar\n");
+
+	if (crear_proceso("amable")<0)
+		printf("Error creando amable\n");
+
+	t0=tiempos_proceso(0);
+	for (i=0; i<TOT_ITER; i++)
+		tot=j*i;
+	t1=tiempos_proceso(&tiempos);
+	printf("prueba_cfs: termina. Real %d Usuario %d\n", t1-t0,
+		tiempos.usuario);
+	tot--;
+	return 0;
+}
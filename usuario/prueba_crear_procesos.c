@@ -0,0 +1,50 @@
+/*
+ * usuario/prueba_crear_procesos.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la creación de varios procesos del mismo
+ * programa con una sola llamada: los mudo creados deben mostrar los
+ * identificadores devueltos y la imagen solo debe cargarse una vez,
+ * incluso sin cache de imagenes (make CACHE_IMAGENES=0). Si falla no
+ * debe devolver ningun identificador.
+ */
+
+#include "servicios.h"
+
+#define NUM_PROCS 5
+
+int main(){
+	int i, n, pids[NUM_PROCS];
+	struct info_imagenes antes, despues;
+
+	printf("prueba_crear_procesos: comienza\n");
+
+	info_imagenes(&antes);
+	n = crear_procesos("mudo", NUM_PROCS, pids);
+	info_imagenes(&despues);
+	printf("prueba_crear_procesos: creados %d procesos con %d cargas de imagen:",
+		n, despues.fallos - antes.fallos);
+	for (i=0; i<n; i++)
+		printf(" %d", pids[i]);
+	printf("\n");
+
+	printf("prueba_crear_procesos: con 0 procesos devuelve %d (DEBE SER ERROR)\n",
+		crear_procesos("mudo", 0, 0));
+	n = crear_procesos("no_existe", NUM_PROCS, pids);
+	printf("prueba_crear_procesos: con un programa que no existe devuelve %d (DEBE SER ERROR)",
+		n);
+	for (i=0; i<NUM_PROCS; i++)
+		printf(" %d", pids[i]);
+	printf(" (DEBEN SER -1)\n");
+	printf("prueba_crear_procesos: con mas procesos que entradas devuelve %d (DEBE SER ERROR)\n",
+		crear_procesos("efimero", 100000, 0));
+
+	printf("prueba_crear_procesos: termina\n");
+	return 0;
+}
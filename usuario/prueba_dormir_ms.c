@@ -0,0 +1,47 @@
+/*
+ * usuario/prueba_dormir_ms.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba las llamadas dormir_ms y dormir_hasta.
+ * Con TICK=100, 250 ms son 25 ticks. El bucle periódico usa plazos
+ * absolutos, por lo que cada vuelta debe despertar exactamente PERIODO
+ * ticks después de la anterior aunque gaste CPU entre medias.
+ */
+
+#include "servicios.h"
+
+#define PERIODO 20	/* en ticks */
+#define VUELTAS 5
+#define TOT_ITER 5000000
+
+int main(){
+	int t0, t1, i, j, tot, tick;
+
+	printf("prueba_dormir_ms: comienza\n");
+
+	t0=tiempos_proceso(0);
+	dormir_ms(250);
+	t1=tiempos_proceso(0);
+	printf("dormir_ms(250): %d ticks\n", t1-t0);
+
+	tick=tiempos_proceso(0);
+	for (i=0; i<VUELTAS; i++){
+		for (j=0; j<TOT_ITER; j++)
+			tot=j*i;
+		tick+=PERIODO;
+		printf("dormir_hasta(%d): despierta en %d\n", tick,
+			dormir_hasta(tick));
+	}
+	tot--;
+
+	printf("dormir_hasta(0) no bloquea: %d\n", dormir_hasta(0));
+
+	printf("prueba_dormir_ms: termina\n");
+	return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * usuario/prueba_edf.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la clase de tiempo real EDF. Es una
+ * tarea periódica (periodo 25, presupuesto 10, plazo 20) que compite con
+ * tarea_tr y con dos simplon que gastan CPU: ninguna de las dos tareas
+ * debe incumplir sus plazos. Comprueba además el control de admisión y
+ * que se contabiliza el exceso de presupuesto. Antes ejecuta tarea_tr sola,
+ * sin ningún otro proceso listo.
+ */
+
+#include "servicios.h"
+
+#define PERIODOS 8
+
+/* gasta el numero de ticks de CPU indicado */
+static void trabajar(int ticks){
+	struct tiempos_ejec t;
+	int fin;
+
+	tiempos_proceso(&t);
+	fin=t.usuario+t.sistema+ticks;
+	do
+		tiempos_proceso(&t);
+	while (t.usuario+t.sistema<fin);
+}
+
+int main(){
+	int i;
+	struct info_tiempo_real info;
+
+	printf("prueba_edf: comienza\n");
+
+	/* una tarea de tiempo real como unico proceso listo */
+	if (crear_proceso("tarea_tr")<0)
+		printf("Error creando tarea_tr\n");
+	else
+		esperar_proceso(-1, 0);
+
+	if (esperar_periodo()!=ERROR_NO_TIEMPO_REAL)
+		printf("esperar_periodo sin ser de tiempo real deberia fallar\n");
+	if (fijar_tiempo_real(10, 5, 20)!=ERROR_PARAMETROS_TR)
+		printf("plazo mayor que el periodo deberia fallar\n");
+
+	if (fijar_tiempo_real(25, 10, 20)<0)
+		printf("prueba_edf: no admitida. NO DEBE APARECER\n");
+
+	/* con la de tarea_tr (0.4) no cabe una utilizacion de 0.7 */
+	if (crear_proceso("tarea_tr")<0)
+		printf("Error creando tarea_tr\n");
+	for (i=0; i<2; i++)
+		if (crear_proceso("simplon")<0)
+			printf("Error creando simplon\n");
+	esperar_periodo();
+	printf("prueba_edf: admision de 0.4 + 0.7: %d (debe ser %d)\n",
+		fijar_tiempo_real(10, 7, 10), ERROR_ADMISION_TR);
+
+	for (i=0; i<PERIODOS; i++){
+		trabajar(8);
+		esperar_periodo();
+	}
+	info_tiempo_real(&info);
+	printf("prueba_edf: plazos incumplidos %d (debe ser 0) excesos %d (debe ser 0)\n",
+		info.plazos_incumplidos, info.excesos_presupuesto);
+
+	/* un periodo en el que gasta mas que su presupuesto: al agotarlo
+	   compite con los simplon, por lo que es probable que incumpla el plazo */
+	trabajar(12);
+	esperar_periodo();
+
+	info_tiempo_real(&info);
+	printf("prueba_edf: termina. Excesos %d (debe ser 1)\n",
+		info.excesos_presupuesto);
+	return 0;
+}
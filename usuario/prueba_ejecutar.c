@@ -0,0 +1,37 @@
+/*
+ * usuario/prueba_ejecutar.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la llamada ejecutar: gasta algo de CPU,
+ * abre un mutex y pasa a ejecutar el programa etapa, que debe mantener su
+ * identificador, sus tiempos y el mutex abierto.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 50000000
+
+int main(){
+	int i, tot = 0;
+	struct tiempos_ejec t;
+
+	printf("prueba_ejecutar (%d): comienza\n", obtener_id_pr());
+
+	for (i=0; i<TOT_ITER; i++)
+		tot += i;
+	tiempos_proceso(&t);
+	printf("prueba_ejecutar (%d): tiempo de usuario %d, mutex %d\n",
+		obtener_id_pr(), t.usuario, crear_mutex("etapa", NO_RECURSIVO));
+
+	printf("prueba_ejecutar: ejecutar de un programa que no existe devuelve %d (DEBE SER ERROR)\n",
+		ejecutar("no_existe"));
+	ejecutar("etapa");
+	printf("prueba_ejecutar: ERROR sigue tras ejecutar\n");
+	return tot;
+}
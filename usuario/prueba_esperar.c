@@ -0,0 +1,54 @@
+/*
+ * usuario/prueba_esperar.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la espera por la terminación de los
+ * hijos: primero a uno concreto, luego a cualquiera, y comprueba los
+ * valores de terminación y los errores.
+ */
+
+#include "servicios.h"
+
+#define NUM_HIJOS 4
+
+static void comprobar(int pid, int estado){
+	printf("prueba_esperar: recogido %d con estado %d%s\n", pid, estado,
+		(estado == pid % 1000) ? "" : " (ERROR)");
+}
+
+int main(){
+	int i, pid, estado, pids[NUM_HIJOS];
+
+	printf("prueba_esperar: comienza\n");
+
+	if (crear_procesos("hijo_estado", NUM_HIJOS, pids) != NUM_HIJOS)
+		printf("Error creando hijo_estado\n");
+
+	pid = esperar_proceso(pids[NUM_HIJOS-1], &estado);
+	comprobar(pid, estado);
+	for (i=0; i<NUM_HIJOS-1; i++){
+		pid = esperar_cualquier_hijo(&estado);
+		comprobar(pid, estado);
+	}
+	printf("prueba_esperar: sin hijos devuelve %d (DEBE SER ERROR)\n",
+		esperar_cualquier_hijo(0));
+	printf("prueba_esperar: a uno ya recogido devuelve %d (DEBE SER ERROR)\n",
+		esperar_proceso(pids[0], 0));
+	printf("prueba_esperar: a si mismo devuelve %d (DEBE SER ERROR)\n",
+		esperar_proceso(obtener_id_pr(), 0));
+
+	if (crear_proceso("excep_arit")<0)
+		printf("Error creando excep_arit\n");
+	pid = esperar_cualquier_hijo(&estado);
+	printf("prueba_esperar: excep_arit (%d) termina con %d (DEBE SER %d)\n",
+		pid, estado, ESTADO_EXCEPCION);
+
+	printf("prueba_esperar: termina\n");
+	return 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * usuario/prueba_estadisticas.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que genera carga (dos simplon y un interactivo) y,
+ * mientras se ejecuta, muestra las estadísticas del planificador con el
+ * programa estadisticas.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_estadisticas: comienza\n");
+
+	for (i=0; i<2; i++)
+		if (crear_proceso("simplon")<0)
+			printf("Error creando simplon\n");
+	if (crear_proceso("interactivo")<0)
+		printf("Error creando interactivo\n");
+
+	dormir(3);
+	if (crear_proceso("estadisticas")<0)
+		printf("Error creando estadisticas\n");
+
+	printf("prueba_estadisticas: termina\n");
+	return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * usuario/prueba_futex.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba el lock y unlock sin llamada al sistema
+ * cuando no hay competencia: compara el coste de un par lock/unlock con el
+ * de un par de llamadas al sistema, comprueba la semántica recursiva y usa
+ * el mismo mutex desde varios hilos con secciones críticas que se ven
+ * expulsadas por fin de rodaja. Por último crea dos procesos intruso que
+ * comparten imagen y comprueba que uno no puede usar el mutex que solo ha
+ * abierto el otro.
+ */
+
+#include "servicios.h"
+
+#define NUM_ITERACIONES 1000000
+#define NUM_HILOS 3
+#define NUM_INCREMENTOS 100000
+
+static int contador = 0;
+static int mutex;
+
+static void incrementar(void *arg){
+	for (int i=0; i<NUM_INCREMENTOS; i++){
+		lock(mutex);
+		int valor = contador;
+		for (volatile int j=0; j<2000; j++)
+			;
+		contador = valor + 1;
+		unlock(mutex);
+	}
+}
+
+int main(){
+	int i, ini, ticks_mutex, ticks_llamadas, rec, tids[NUM_HILOS], pids[2];
+
+	printf("prueba_futex: comienza\n");
+	if ((mutex = crear_mutex("futex", NO_RECURSIVO)) < 0)
+		printf("Error creando mutex\n");
+	if ((rec = crear_mutex("futexr", RECURSIVO)) < 0)
+		printf("Error creando mutex recursivo\n");
+
+	ini = tiempos_proceso(0);
+	for (i=0; i<NUM_ITERACIONES; i++){
+		lock(mutex);
+		unlock(mutex);
+	}
+	ticks_mutex = tiempos_proceso(0) - ini;
+
+	ini = tiempos_proceso(0);
+	for (i=0; i<NUM_ITERACIONES; i++){
+		obtener_id_pr();
+		obtener_id_pr();
+	}
+	ticks_llamadas = tiempos_proceso(0) - ini;
+	printf("prueba_futex: %d lock/unlock sin competencia en %d ticks, %d pares de llamadas en %d ticks\n",
+		NUM_ITERACIONES, ticks_mutex, NUM_ITERACIONES, ticks_llamadas);
+
+	/* semántica: recursivo anidado, segundo lock no recursivo y unlock ajeno */
+	lock(mutex);
+	if (lock(mutex) < 0)
+		printf("segundo lock en mutex no recursivo. DEBE APARECER\n");
+	unlock(mutex);
+	if (unlock(mutex) < 0)
+		printf("unlock de mutex libre. DEBE APARECER\n");
+	if (lock(rec) < 0 || lock(rec) < 0 || unlock(rec) < 0)
+		printf("error en lock recursivo. NO DEBE APARECER\n");
+	if (trylock(rec) < 0 || unlock(rec) < 0 || unlock(rec) < 0)
+		printf("error en unlock recursivo. NO DEBE APARECER\n");
+	if (unlock(rec) < 0)
+		printf("unlock adicional de mutex recursivo. DEBE APARECER\n");
+	if (lock(mutex+rec+1) < 0)
+		printf("lock de descriptor no abierto. DEBE APARECER\n");
+
+	/* competencia entre hilos */
+	for (i=0; i<NUM_HILOS; i++)
+		if ((tids[i] = crear_hilo(incrementar, 0)) < 0)
+			printf("Error creando hilo\n");
+	for (i=0; i<NUM_HILOS; i++)
+		esperar_proceso(tids[i], 0);
+	printf("prueba_futex: contador %d (DEBE SER %d)\n",
+		contador, NUM_HILOS*NUM_INCREMENTOS);
+
+	/* procesos del mismo programa: la palabra de uno no vale para el otro */
+	if (crear_procesos("intruso", 2, pids) < 0)
+		printf("Error creando intruso\n");
+	else
+		for (i=0; i<2; i++)
+			esperar_proceso(pids[i], 0);
+
+	printf("prueba_futex: termina\n");
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * usuario/prueba_herencia.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la herencia de prioridad con una cadena
+ * de mutex (con la política PLANIF_PRIORIDADES). El hilo bajo (prioridad
+ * 1) tiene m1 en una sección crítica larga; el hilo intermedio
+ * (prioridad 2) tiene m2 y espera m1; un hilo de cálculo (prioridad 4)
+ * compite por el procesador; y el principal (prioridad máxima) pide m2.
+ * Con herencia, los dos primeros heredan la prioridad máxima y el
+ * principal obtiene m2 en cuanto terminan sus secciones críticas, sin
+ * esperar al de cálculo.
+ */
+
+#include "servicios.h"
+
+#define TICKS_SECCION 30	/* de CPU dentro de m1 */
+#define TICKS_CALCULO 200	/* de CPU del hilo de prioridad 4 */
+
+static int m1, m2;
+
+static int ticks_cpu(){
+	struct tiempos_ejec t;
+
+	tiempos_proceso(&t);
+	return t.usuario + t.sistema;
+}
+
+static void trabajar(int ticks){
+	int ini = ticks_cpu();
+
+	while (ticks_cpu() - ini < ticks)
+		;
+}
+
+static void bajo(void *arg){
+	fijar_prioridad(1);
+	lock(m1);
+	trabajar(TICKS_SECCION);
+	unlock(m1);
+	printf("bajo: libera m1\n");
+}
+
+static void intermedio(void *arg){
+	fijar_prioridad(2);
+	lock(m2);
+	lock(m1);
+	unlock(m1);
+	unlock(m2);
+	printf("intermedio: libera m2\n");
+}
+
+static void calculo(void *arg){
+	fijar_prioridad(4);
+	trabajar(TICKS_CALCULO);
+	printf("calculo: termina\n");
+}
+
+int main(){
+	int ini, espera, tids[3];
+
+	printf("prueba_herencia: comienza\n");
+	fijar_prioridad(PRIORIDAD_MAXIMA);
+	if ((m1 = crear_mutex("m1", NO_RECURSIVO)) < 0 ||
+	    (m2 = crear_mutex("m2", NO_RECURSIVO)) < 0)
+		printf("Error creando mutex\n");
+
+	/* cada hilo ejecuta mientras el principal duerme hasta quedar bloqueado */
+	tids[0] = crear_hilo(bajo, 0);
+	dormir_ms(50);
+	tids[1] = crear_hilo(intermedio, 0);
+	dormir_ms(50);
+	tids[2] = crear_hilo(calculo, 0);
+
+	ini = tiempos_proceso(0);
+	lock(m2);
+	espera = tiempos_proceso(0) - ini;
+	unlock(m2);
+	printf("prueba_herencia: obtiene m2 tras %d ticks (DEBE SER MENOR QUE %d)\n",
+		espera, TICKS_CALCULO);
+
+	for (int i=0; i<3; i++)
+		esperar_proceso(tids[i], 0);
+	printf("prueba_herencia: termina\n");
+	return 0;
+}
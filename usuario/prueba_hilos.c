@@ -0,0 +1,85 @@
+/*
+ * usuario/prueba_hilos.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba los hilos: varios hilos incrementan un
+ * contador global compartido protegido por un mutex abierto antes de
+ * crearlos, y el programa espera a que terminen todos. Después comprueba
+ * que los hilos comparten los descriptores de mutex: un hilo usa uno que
+ * se abre después de crearlo, no se puede cerrar mientras lo tiene, y el
+ * que abre el hilo sigue abierto cuando termina.
+ */
+
+#include "servicios.h"
+
+#define NUM_HILOS 4
+#define NUM_INCREMENTOS 1000
+
+static int contador = 0;
+static int mutex;
+static int tardio = -1, del_hilo = -1;
+
+static void incrementar(void *arg){
+	int i, n = (long) arg;
+
+	printf("hilo %d (%d): comienza\n", n, obtener_id_pr());
+	for (i=0; i<NUM_INCREMENTOS; i++){
+		lock(mutex);
+		contador++;
+		unlock(mutex);
+	}
+	printf("hilo %d (%d): termina\n", n, obtener_id_pr());
+}
+
+static void usar_tardio(void *arg){
+	while (tardio < 0)
+		dormir_ms(10);
+	printf("hilo tardio: lock de un mutex abierto tras crearlo %d (DEBE SER 0)\n",
+		lock(tardio));
+	dormir_ms(100);
+	unlock(tardio);
+	del_hilo = crear_mutex("del_hilo", NO_RECURSIVO);
+}
+
+int main(){
+	int i, tids[NUM_HILOS];
+	struct info_imagenes antes, despues;
+
+	printf("prueba_hilos: comienza\n");
+	if ((mutex = crear_mutex("cont", NO_RECURSIVO)) < 0)
+		printf("Error creando mutex\n");
+
+	info_imagenes(&antes);
+	for (i=0; i<NUM_HILOS; i++)
+		if ((tids[i] = crear_hilo(incrementar, (void *)(long) i)) < 0)
+			printf("Error creando hilo\n");
+	info_imagenes(&despues);
+
+	for (i=0; i<NUM_HILOS; i++)
+		esperar_proceso(tids[i], 0);
+	printf("prueba_hilos: contador %d (DEBE SER %d), %d imagenes cargadas (DEBE SER 0)\n",
+		contador, NUM_HILOS*NUM_INCREMENTOS,
+		despues.fallos + despues.aciertos - antes.fallos - antes.aciertos);
+
+	/* descriptores de mutex comunes a los hilos */
+	tids[0] = crear_hilo(usar_tardio, 0);
+	tardio = crear_mutex("tardio", NO_RECURSIVO);
+	dormir_ms(50);
+	printf("prueba_hilos: cerrar el mutex que tiene el hilo %d (DEBE SER %d)\n",
+		cerrar_mutex(tardio), ERROR_MUTEX_OCUPADO);
+	esperar_proceso(tids[0], 0);
+	printf("prueba_hilos: lock del mutex que abrio el hilo ya terminado %d (DEBE SER 0)\n",
+		lock(del_hilo));
+	unlock(del_hilo);
+	printf("prueba_hilos: cerrar el mutex ya libre %d (DEBE SER 0)\n",
+		cerrar_mutex(tardio));
+
+	printf("prueba_hilos: termina\n");
+	return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * usuario/prueba_imagenes.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que mide el tiempo de carga de imágenes al crear
+ * procesos del mismo programa, en ráfaga y de uno en uno esperando a que
+ * termine cada uno (sin cache cada uno vuelve a cargar el programa). Para comparar, se puede
+ * compilar el sistema con "make CACHE_IMAGENES=0".
+ */
+
+#include "servicios.h"
+
+#define NUM_RAFAGA 100
+#define NUM_SECUENCIAL 100
+
+static struct info_imagenes previa;
+
+static void imp_imagenes(char *fase){
+	struct info_imagenes info;
+
+	info_imagenes(&info);
+	printf("prueba_imagenes: %s: aciertos %d fallos %d expulsiones %d, %d ms de carga\n",
+		fase, info.aciertos - previa.aciertos,
+		info.fallos - previa.fallos, info.expulsiones - previa.expulsiones,
+		info.ms_carga - previa.ms_carga);
+	previa = info;
+}
+
+int main(){
+	int i;
+
+	printf("prueba_imagenes: comienza\n");
+	info_imagenes(&previa);
+
+	for (i=0; i<NUM_RAFAGA; i++)
+		if (crear_proceso("efimero")<0)
+			printf("Error creando efimero\n");
+	imp_imagenes("rafaga");
+	dormir(1);
+
+	for (i=0; i<NUM_SECUENCIAL; i++){
+		if (crear_proceso("efimero")<0)
+			printf("Error creando efimero\n");
+		dormir_ms(20);
+	}
+	imp_imagenes("de uno en uno");
+
+	printf("prueba_imagenes: termina\n");
+	return 0;
+}
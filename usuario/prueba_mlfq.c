@@ -0,0 +1,34 @@
+/*
+ * usuario/prueba_mlfq.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la política MLFQ
+ * (requiere compilar el sistema con "make PLANIF=PLANIF_MLFQ"): un proceso
+ * que duerme compite con procesos que gastan CPU. Con MLFQ el retraso al
+ * despertar debe ser casi nulo; con prioridades fijas espera a que los
+ * demás agoten su rodaja.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_mlfq: comienza\n");
+
+	for (i=1; i<=3; i++)
+		if (crear_proceso("simplon")<0)
+			printf("Error creando simplon\n");
+
+	if (crear_proceso("interactivo")<0)
+		printf("Error creando interactivo\n");
+
+	printf("prueba_mlfq: termina\n");
+	return 0; 
+}
@@ -0,0 +1,57 @@
+/*
+ * usuario/prueba_pilas.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la reserva de pilas y el tamaño de pila
+ * de los procesos creados: la segunda tanda de procesos debe reutilizar
+ * las pilas de la primera y con pilas pequeñas los procesos deben
+ * funcionar igual.
+ */
+
+#include "servicios.h"
+
+#define NUM_PROCS 10
+
+static void crear_tanda(char *prog){
+	int i;
+
+	for (i=0; i<NUM_PROCS; i++)
+		if (crear_proceso(prog)<0)
+			printf("Error creando %s\n", prog);
+	dormir(1);
+}
+
+static void imp_pilas(char *fase){
+	struct info_pilas info;
+
+	info_pilas(&info);
+	printf("prueba_pilas: %s: aciertos %d fallos %d descartadas %d en reserva %d\n",
+		fase, info.aciertos, info.fallos, info.descartadas, info.en_reserva);
+}
+
+int main(){
+	printf("prueba_pilas: comienza\n");
+
+	crear_tanda("efimero");
+	imp_pilas("primera tanda");
+	crear_tanda("efimero");
+	imp_pilas("segunda tanda (debe reutilizar sus pilas)");
+
+	printf("prueba_pilas: fijar_tam_pila(100) devuelve %d (DEBE SER ERROR)\n",
+		fijar_tam_pila(100));
+	printf("prueba_pilas: fijar_tam_pila(20000) devuelve %d (DEBE SER 32768)\n",
+		fijar_tam_pila(20000));
+	printf("prueba_pilas: fijar_tam_pila(%d) devuelve %d\n", TAM_PILA_MINIMA,
+		fijar_tam_pila(TAM_PILA_MINIMA));
+	crear_tanda("mudo");
+	imp_pilas("tanda con pila minima");
+
+	printf("prueba_pilas: termina\n");
+	return 0;
+}
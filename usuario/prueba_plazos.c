@@ -0,0 +1,42 @@
+/*
+ * usuario/prueba_plazos.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba trylock, lock_timeout y las lecturas
+ * del terminal con plazo y sin bloqueo (NO PULSE NINGUNA TECLA). Crea el
+ * mutex mp, lo bloquea y crea esperador, que intenta obtenerlo; lo libera
+ * al cabo de un segundo.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int desc;
+
+	printf("prueba_plazos: comienza\n");
+
+	if ((desc=crear_mutex("mp", NO_RECURSIVO))<0)
+		printf("error creando mp. NO DEBE APARECER\n");
+
+	if (lock(desc)<0)
+		printf("error en lock de mutex. NO DEBE APARECER\n");
+
+	if (crear_proceso("esperador")<0)
+		printf("Error creando esperador\n");
+
+	printf("prueba_plazos duerme 1 seg. con mp bloqueado\n");
+	dormir(1);
+
+	printf("prueba_plazos libera mp: debe despertar a esperador\n");
+	if (unlock(desc)<0)
+		printf("error en unlock de mutex. NO DEBE APARECER\n");
+
+	printf("prueba_plazos: termina\n");
+	return 0;
+}
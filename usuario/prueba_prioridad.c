@@ -0,0 +1,35 @@
+/*
+ * usuario/prueba_prioridad.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de las colas de listos por
+ * prioridad: el proceso que sube su prioridad debe terminar antes que los
+ * procesos creados antes que él.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_prioridad: comienza\n");
+
+	if (fijar_prioridad(PRIORIDAD_MAXIMA+1)>=0)
+		printf("fijar_prioridad con valor incorrecto. NO DEBE SALIR\n");
+
+	for (i=1; i<=2; i++)
+		if (crear_proceso("simplon")<0)
+			printf("Error creando simplon\n");
+
+	if (crear_proceso("prioritario")<0)
+		printf("Error creando prioritario\n");
+
+	printf("prueba_prioridad: termina\n");
+	return 0; 
+}
@@ -0,0 +1,45 @@
+/*
+ * usuario/prueba_procesos.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la tabla de procesos: crea cientos de
+ * procesos en tandas, esperando a que terminen los de cada una, y, tras
+ * reutilizarse sus entradas, crea varios mudo que muestran su
+ * identificador, que incluye la generación de la entrada.
+ */
+
+#include "servicios.h"
+
+#define NUM_TANDAS 3
+#define PROCS_TANDA 200
+
+int main(){
+	int i, j, creados = 0;
+
+	printf("prueba_procesos (%d): comienza\n", obtener_id_pr());
+
+	for (i=0; i<NUM_TANDAS; i++){
+		for (j=0; j<PROCS_TANDA; j++)
+			if (crear_proceso("efimero")==0)
+				creados++;
+		printf("prueba_procesos: tanda %d, %d procesos creados\n", i, creados);
+		// Recoge a los hijos para que sus entradas queden libres
+		while (esperar_cualquier_hijo(0) >= 0)
+			;
+	}
+	if (creados < NUM_TANDAS*PROCS_TANDA)
+		printf("prueba_procesos: ERROR no se han podido crear todos\n");
+
+	for (i=0; i<3; i++)
+		if (crear_proceso("mudo")<0)
+			printf("Error creando mudo\n");
+
+	printf("prueba_procesos: termina\n");
+	return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * usuario/prueba_registro_mutex.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la tabla de mutex ampliable y su índice
+ * por nombre. Si se arranca con MAX_MUTEX, debe ser al menos
+ * 4*(NUM_POSEEDORES+1).
+ */
+
+#include "servicios.h"
+
+#define NUM_NOMBRES 500
+#define NUM_POSEEDORES 60
+
+static char *nombre_num(char *buf, int n){
+	int j = 7;
+
+	buf[8] = '\0';
+	do {
+		buf[j--] = '0' + n%10;
+		n /= 10;
+	} while (n > 0);
+	buf[j] = 'r';
+	return &buf[j];
+}
+
+int main(){
+	char buf[9];
+	char *nombre;
+	int desc, max_desc = 0, errores = 0;
+	int pids[NUM_POSEEDORES];
+
+	printf("prueba_registro_mutex: comienza\n");
+
+	/* Crear, abrir por nombre y cerrar muchos mutex distintos */
+	for (int i=0; i<NUM_NOMBRES; i++){
+		nombre = nombre_num(buf, i);
+		if ((desc = crear_mutex(nombre, NO_RECURSIVO)) < 0){
+			errores++;
+			continue;
+		}
+		if (desc > max_desc)
+			max_desc = desc;
+		if (abrir_mutex(nombre) != desc)
+			errores++;
+		if (crear_mutex(nombre, NO_RECURSIVO) >= 0)
+			errores++;
+		cerrar_mutex(desc);
+		if (abrir_mutex(nombre) >= 0)
+			errores++;
+	}
+	printf("prueba_registro_mutex: %d nombres con %d errores (DEBE SER 0) y descriptor maximo %d\n",
+		NUM_NOMBRES, errores, max_desc);
+
+	/* Muchos mutex vivos a la vez repartidos entre procesos */
+	if (crear_procesos("poseedor", NUM_POSEEDORES, pids) < 0)
+		printf("prueba_registro_mutex: error creando poseedores\n");
+	for (int i=0; i<NUM_POSEEDORES; i++)
+		esperar_cualquier_hijo(0);
+	printf("prueba_registro_mutex: han terminado %d poseedores con %d mutex cada uno\n",
+		NUM_POSEEDORES, 4);
+
+	printf("prueba_registro_mutex: termina\n");
+	return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * usuario/prueba_rodaja.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la rodaja adaptativa: mientras gasta
+ * CPU compitiendo con un simplon la rodaja debe crecer hasta el máximo y,
+ * al pasar a dormir a menudo, debe volver a reducirse.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 200000000	/* ponga las que considere oportuno */
+
+static void imp_rodaja(char *fase){
+	struct info_rodaja info;
+
+	info_rodaja(&info);
+	printf("prueba_rodaja: %s: rodaja %d adaptativa %d agotadas %d bloqueos tempranos %d\n",
+		fase, info.rodaja, info.adaptativa, info.rodajas_agotadas,
+		info.bloqueos_tempranos);
+}
+
+int main(){
+	int i, tot;
+	int j=5;
+
+	printf("prueba_rodaja: comienza\n");
+
+	if (fijar_rodaja(0, 0)!=ERROR_RODAJA)
+		printf("fijar_rodaja(0) deberia fallar\n");
+
+	printf("prueba_rodaja: rodaja anterior %d\n", fijar_rodaja(5, 1));
+	imp_rodaja("inicio");
+
+	if (crear_proceso("simplon")<0)
+		printf("Error creando simplon\n");
+
+	for (i=0; i<TOT_ITER; i++)
+		tot=j*i;
+	tot--;
+	imp_rodaja("tras gastar CPU");
+
+	for (i=0; i<10; i++)
+		dormir_ms(10);
+	imp_rodaja("tras dormir");
+
+	printf("prueba_rodaja: termina\n");
+	return 0;
+}
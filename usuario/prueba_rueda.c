@@ -0,0 +1,54 @@
+/*
+ * usuario/prueba_rueda.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que mide el coste de tener muchos procesos dormidos:
+ * ejecuta el mismo bucle de cálculo sin dormidos y con tantos procesos
+ * "siestas" como quepan en la tabla de procesos (hasta MAX_DORMIDOS).
+ * Con la rueda de plazos el tiempo de ambas medidas debe ser parecido,
+ * porque cada tick solo trata la cubeta que vence.
+ */
+
+#include "servicios.h"
+
+#define MAX_DORMIDOS 300
+#define TOT_ITER 100000000	/* ponga las que considere oportuno */
+
+static int medir_bucle(){
+	int i, tot, inicio;
+	int j=5;
+
+	inicio=tiempos_proceso(0);
+	for (i=0; i<TOT_ITER; i++)
+		tot=j*i;
+	tot--;
+	return tiempos_proceso(0)-inicio;
+}
+
+int main(){
+	int n, ticks;
+
+	printf("prueba_rueda: comienza\n");
+
+	ticks=medir_bucle();
+	printf("prueba_rueda: bucle sin dormidos: %d ticks\n", ticks);
+
+	for (n=0; n<MAX_DORMIDOS; n++)
+		if (crear_proceso("siestas")<0)
+			break;
+
+	/* deja que todos se duerman antes de medir */
+	dormir(1);
+
+	ticks=medir_bucle();
+	printf("prueba_rueda: bucle con %d dormidos: %d ticks\n", n, ticks);
+
+	printf("prueba_rueda: termina\n");
+	return 0;
+}
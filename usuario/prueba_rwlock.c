@@ -0,0 +1,143 @@
+/*
+ * usuario/prueba_rwlock.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba los rwlock: los errores al mezclarlos
+ * con los mutex, que los lectores no se esperan entre sí (varios hilos
+ * que mantienen el rdlock mientras duermen tardan lo que uno y con
+ * wrlock lo que todos), el orden en que lo obtienen con cada
+ * preferencia y su liberación implícita al terminar el hilo que lo tiene.
+ */
+
+#include "servicios.h"
+
+#define N_HILOS 4
+#define MS_SECCION 200
+
+static int rw;
+static char orden[8];
+static int n_orden;
+
+static void anotar(char c){
+	orden[n_orden++] = c;
+	orden[n_orden] = '\0';
+}
+
+static void lector(void *arg){
+	rdlock(rw);
+	dormir_ms(MS_SECCION);
+	rwunlock(rw);
+}
+
+static void escritor(void *arg){
+	wrlock(rw);
+	dormir_ms(MS_SECCION);
+	rwunlock(rw);
+}
+
+/* Mide los ticks que tardan N_HILOS hilos en pasar por la sección */
+static int medir(void (*funcion)(void *)){
+	int ini, tids[N_HILOS];
+
+	ini = tiempos_proceso(0);
+	for (int i=0; i<N_HILOS; i++)
+		tids[i] = crear_hilo(funcion, 0);
+	for (int i=0; i<N_HILOS; i++)
+		esperar_proceso(tids[i], 0);
+	return tiempos_proceso(0) - ini;
+}
+
+static void lector1(void *arg){
+	rdlock(rw);
+	anotar('1');
+	dormir_ms(100);
+	rwunlock(rw);
+}
+
+static void lector2(void *arg){
+	rdlock(rw);
+	anotar('2');
+	rwunlock(rw);
+}
+
+static void escritor_orden(void *arg){
+	wrlock(rw);
+	anotar('W');
+	rwunlock(rw);
+}
+
+/*
+ * lector1 lo tiene cuando llega el escritor y luego lector2: con
+ * preferencia de lectores entra lector2 antes que el escritor
+ */
+static void probar_orden(char *nombre, int preferencia, char *esperado){
+	int tids[3];
+
+	n_orden = 0;
+	rw = crear_rwlock(nombre, preferencia);
+	tids[0] = crear_hilo(lector1, 0);
+	dormir_ms(20);
+	tids[1] = crear_hilo(escritor_orden, 0);
+	dormir_ms(20);
+	tids[2] = crear_hilo(lector2, 0);
+	for (int i=0; i<3; i++)
+		esperar_proceso(tids[i], 0);
+	printf("prueba_rwlock: orden con %s %s (DEBE SER %s)\n", nombre, orden, esperado);
+	cerrar_rwlock(rw);
+}
+
+static void sale_con_escritura(void *arg){
+	wrlock(rw);
+}
+
+static void sale_con_lectura(void *arg){
+	rdlock(rw);
+	rdlock(rw);
+}
+
+int main(){
+	int m, tid, t_lect, t_escr;
+
+	printf("prueba_rwlock: comienza\n");
+
+	/* Errores por tipo */
+	rw = crear_rwlock("rw", PREFERENCIA_LECTORES);
+	m = crear_mutex("m", NO_RECURSIVO);
+	printf("prueba_rwlock: abrir_mutex de rwlock %d, lock %d, rdlock de mutex %d (DEBEN SER %d)\n",
+		abrir_mutex("rw"), lock(rw), rdlock(m), ERROR_TIPO_MUTEX);
+	printf("prueba_rwlock: rwunlock sin tenerlo %d (DEBE SER NEGATIVO)\n", rwunlock(rw));
+	wrlock(rw);
+	printf("prueba_rwlock: rdlock con wrlock %d (DEBE SER NEGATIVO)\n", rdlock(rw));
+	rwunlock(rw);
+	cerrar_mutex(m);
+
+	/* Los lectores no se esperan entre sí */
+	t_lect = medir(lector);
+	t_escr = medir(escritor);
+	printf("prueba_rwlock: %d lectores tardan %d ticks y %d escritores %d\n",
+		N_HILOS, t_lect, N_HILOS, t_escr);
+	cerrar_rwlock(rw);
+
+	probar_orden("rw_lect", PREFERENCIA_LECTORES, "12W");
+	probar_orden("rw_escr", PREFERENCIA_ESCRITORES, "1W2");
+
+	/* Al terminar un hilo se cierra el rwlock y se libera lo que tenga */
+	rw = crear_rwlock("rw_impl", PREFERENCIA_ESCRITORES);
+	tid = crear_hilo(sale_con_escritura, 0);
+	esperar_proceso(tid, 0);
+	printf("prueba_rwlock: rdlock tras terminar el escritor %d (DEBE SER 0)\n", rdlock(rw));
+	rwunlock(rw);
+	tid = crear_hilo(sale_con_lectura, 0);
+	esperar_proceso(tid, 0);
+	printf("prueba_rwlock: wrlock tras terminar el lector %d (DEBE SER 0)\n", wrlock(rw));
+	cerrar_rwlock(rw);
+
+	printf("prueba_rwlock: termina\n");
+	return 0;
+}
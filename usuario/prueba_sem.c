@@ -0,0 +1,97 @@
+/*
+ * usuario/prueba_sem.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba los semáforos: los errores, que un
+ * sem_post con varios hilos esperando despierta solo a uno, y un
+ * productor y un consumidor con un buffer circular de TAM_BUFFER
+ * elementos protegido por un mutex.
+ */
+
+#include "servicios.h"
+
+#define N_ESPERAN 3
+#define TAM_BUFFER 4
+#define N_ELEMENTOS 100
+
+static int sem, huecos, elementos, mutex;
+static int despertados;
+static int buffer[TAM_BUFFER];
+
+static void esperar(void *arg){
+	sem_wait(sem);
+	despertados++;
+}
+
+static void productor(void *arg){
+	for (int i=1, pos=0; i<=N_ELEMENTOS; i++, pos=(pos+1)%TAM_BUFFER){
+		sem_wait(huecos);
+		lock(mutex);
+		buffer[pos] = i;
+		unlock(mutex);
+		sem_post(elementos);
+	}
+}
+
+static void consumidor(void *arg){
+	int suma = 0;
+
+	for (int i=0, pos=0; i<N_ELEMENTOS; i++, pos=(pos+1)%TAM_BUFFER){
+		sem_wait(elementos);
+		lock(mutex);
+		suma += buffer[pos];
+		unlock(mutex);
+		sem_post(huecos);
+	}
+	printf("prueba_sem: consumidor suma %d (DEBE SER %d)\n", suma,
+		N_ELEMENTOS*(N_ELEMENTOS+1)/2);
+}
+
+int main(){
+	int err, tids[N_ESPERAN];
+
+	printf("prueba_sem: comienza\n");
+
+	/* Errores */
+	printf("prueba_sem: crear_sem con valor negativo %d (DEBE SER NEGATIVO)\n",
+		crear_sem("neg", -1));
+	sem = crear_sem("sem", 1);
+	printf("prueba_sem: abrir_mutex de semaforo %d, lock %d (DEBEN SER %d)\n",
+		abrir_mutex("sem"), lock(sem), ERROR_TIPO_MUTEX);
+	err = sem_trywait(sem);
+	printf("prueba_sem: sem_trywait a 1 %d, a 0 %d (DEBEN SER 0 y %d)\n",
+		err, sem_trywait(sem), ERROR_SEM_OCUPADO);
+
+	/* Un sem_post despierta a uno solo de los que esperan */
+	for (int i=0; i<N_ESPERAN; i++)
+		tids[i] = crear_hilo(esperar, 0);
+	dormir_ms(50);
+	sem_post(sem);
+	dormir_ms(50);
+	printf("prueba_sem: tras un sem_post despiertan %d (DEBE SER 1)\n", despertados);
+	for (int i=1; i<N_ESPERAN; i++)
+		sem_post(sem);
+	for (int i=0; i<N_ESPERAN; i++)
+		esperar_proceso(tids[i], 0);
+	printf("prueba_sem: tras %d sem_post despiertan %d y vale 0: sem_trywait %d (DEBE SER %d)\n",
+		N_ESPERAN, despertados, sem_trywait(sem), ERROR_SEM_OCUPADO);
+	cerrar_sem(sem);
+
+	/* Productor y consumidor */
+	huecos = crear_sem("huecos", TAM_BUFFER);
+	elementos = crear_sem("llenos", 0);
+	mutex = crear_mutex("buffer", NO_RECURSIVO);
+	tids[0] = crear_hilo(productor, 0);
+	tids[1] = crear_hilo(consumidor, 0);
+	esperar_proceso(tids[0], 0);
+	esperar_proceso(tids[1], 0);
+
+	printf("prueba_sem: termina\n");
+	return 0;
+}
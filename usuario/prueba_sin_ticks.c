@@ -0,0 +1,80 @@
+/*
+ * usuario/prueba_sin_ticks.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que comprueba que el reloj sin ticks no cambia lo
+ * que devuelve tiempos_proceso:
+ * - Al despertar tras dormir con el procesador inactivo su tiempo de
+ *   procesador no debe crecer con lo que ha estado inactivo.
+ * - Si calcula sin hacer llamadas como único proceso listo y se bloquea
+ *   en un semáforo hasta que lo despierta un hilo, no debe perder lo
+ *   calculado antes de bloquearse. Lo que tarda cada cálculo se mide
+ *   antes con otro igual terminado con una llamada.
+ */
+
+#include "servicios.h"
+
+#define MS_DORMIDO 500
+#define VUELTAS 10
+#define ITERACIONES 40000000
+
+static int sem;
+
+static int ticks_cpu(){
+	struct tiempos_ejec t;
+
+	tiempos_proceso(&t);
+	return t.usuario + t.sistema;
+}
+
+static void calcular(){
+	volatile int n = 0;
+
+	for (int i=0; i<ITERACIONES; i++)
+		n++;
+}
+
+static void despertador(void *arg){
+	for (int i=0; i<VUELTAS; i++){
+		dormir_ms(MS_DORMIDO);
+		sem_post(sem);
+	}
+}
+
+int main(){
+	int ini, medio, dormido, calculo = 0, bloqueado = 0, tid;
+
+	printf("prueba_sin_ticks: comienza\n");
+	sem = crear_sem("sem", 0);
+
+	/* Durmiendo sin procesos listos */
+	ini = ticks_cpu();
+	for (int i=0; i<VUELTAS; i++)
+		dormir_ms(MS_DORMIDO);
+	dormido = ticks_cpu() - ini;
+	printf("prueba_sin_ticks: %d ticks de procesador en %d dormidos (DEBEN SER MENOS DE %d)\n",
+		dormido, VUELTAS*MS_DORMIDO/10, VUELTAS);
+
+	/* Calculando y esperando en el semáforo a que lo despierte el hilo */
+	tid = crear_hilo(despertador, 0);
+	for (int i=0; i<VUELTAS; i++){
+		ini = ticks_cpu();
+		calcular();
+		medio = ticks_cpu();
+		calcular();
+		sem_wait(sem);
+		calculo += medio - ini;
+		bloqueado += ticks_cpu() - medio;
+	}
+	esperar_proceso(tid, 0);
+	printf("prueba_sin_ticks: %d ticks de procesador calculando antes de bloquearse (DEBEN SER UNOS %d)\n",
+		bloqueado, calculo);
+	printf("prueba_sin_ticks: termina\n");
+	return 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * usuario/prueba_stride.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la política stride
+ * (requiere compilar el sistema con "make PLANIF=PLANIF_STRIDE"): crea
+ * tres accionistas con 70, 20 y 10 tickets, que heredan de él, y cada uno
+ * debe recibir aproximadamente ese porcentaje del procesador. Con Round
+ * Robin todos reciben un tercio.
+ */
+
+#include "servicios.h"
+
+int main(){
+	printf("prueba_stride: comienza\n");
+
+	if (fijar_tickets(TICKETS_MAXIMO+1)!=ERROR_TICKETS)
+		printf("fijar_tickets(%d) deberia fallar\n", TICKETS_MAXIMO+1);
+
+	fijar_tickets(70);
+	if (crear_proceso("accionista")<0)
+		printf("Error creando accionista\n");
+	fijar_tickets(20);
+	if (crear_proceso("accionista")<0)
+		printf("Error creando accionista\n");
+	fijar_tickets(10);
+	if (crear_proceso("accionista")<0)
+		printf("Error creando accionista\n");
+
+	printf("prueba_stride: termina\n");
+	return 0;
+}
@@ -0,0 +1,46 @@
+/*
+ * usuario/prueba_tabla_llena.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la creación de procesos con la tabla de
+ * procesos llena: crear_proceso falla, crear_proceso_timeout falla al
+ * vencer el plazo y crear_proceso_bloq espera a que termine un durmiente
+ * (un segundo después de llenarse la tabla).
+ */
+
+#include "servicios.h"
+
+int main(){
+	int ini, res;
+
+	printf("prueba_tabla_llena: comienza\n");
+
+	if (crear_proceso("llenador")<0)
+		printf("Error creando llenador\n");
+	esperar_cualquier_hijo(0);
+
+	/* ocupa la entrada que ha liberado el llenador al recogerlo */
+	crear_proceso("durmiente");
+
+	printf("prueba_tabla_llena: crear_proceso devuelve %d (DEBE SER ERROR)\n",
+		crear_proceso("efimero"));
+
+	ini = tiempos_proceso(0);
+	res = crear_proceso_timeout("efimero", 200);
+	printf("prueba_tabla_llena: crear_proceso_timeout de 200 ms devuelve %d (DEBE SER %d) tras %d ticks\n",
+		res, ERROR_PLAZO_CREAR, tiempos_proceso(0) - ini);
+
+	ini = tiempos_proceso(0);
+	res = crear_proceso_bloq("efimero");
+	printf("prueba_tabla_llena: crear_proceso_bloq devuelve %d tras %d ticks\n",
+		res, tiempos_proceso(0) - ini);
+
+	printf("prueba_tabla_llena: termina\n");
+	return 0;
+}
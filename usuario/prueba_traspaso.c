@@ -0,0 +1,79 @@
+/*
+ * usuario/prueba_traspaso.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que mide la competencia por un mutex entre varios
+ * hilos. Para comparar el traspaso del mutex en unlock con el
+ * comportamiento anterior hay que ejecutarlo con el núcleo compilado con
+ * "make" y con "make TRASPASO_MUTEX=0". Muestra los ticks empleados, los
+ * cambios de contexto voluntarios (bloqueos) y cuánto había avanzado el
+ * hilo más retrasado cuando termina el primero.
+ */
+
+#include "servicios.h"
+
+#define NUM_HILOS 4
+#define NUM_VUELTAS 100000
+#define ESPERA_DENTRO 1000
+#define ESPERA_FUERA 1000
+
+static int mutex;
+static int vueltas[NUM_HILOS];
+static int primero_en_terminar = -1, avance_min = NUM_VUELTAS;
+
+static void competir(void *arg){
+	int n = (long) arg;
+
+	for (int i=0; i<NUM_VUELTAS; i++){
+		lock(mutex);
+		vueltas[n]++;
+		for (volatile int j=0; j<ESPERA_DENTRO; j++)
+			;
+		unlock(mutex);
+		for (volatile int j=0; j<ESPERA_FUERA; j++)
+			;
+	}
+
+	lock(mutex);
+	if (primero_en_terminar < 0){
+		primero_en_terminar = n;
+		for (int k=0; k<NUM_HILOS; k++)
+			if (k != n && vueltas[k] < avance_min)
+				avance_min = vueltas[k];
+	}
+	unlock(mutex);
+}
+
+int main(){
+	int i, ini, tids[NUM_HILOS];
+	struct estadisticas_planif antes, despues;
+
+	printf("prueba_traspaso: comienza\n");
+	if ((mutex = crear_mutex("trasp", NO_RECURSIVO)) < 0)
+		printf("Error creando mutex\n");
+
+	estadisticas_planif(-1, &antes);
+	ini = tiempos_proceso(0);
+	for (i=0; i<NUM_HILOS; i++)
+		if ((tids[i] = crear_hilo(competir, (void *)(long) i)) < 0)
+			printf("Error creando hilo\n");
+	for (i=0; i<NUM_HILOS; i++)
+		esperar_proceso(tids[i], 0);
+	estadisticas_planif(-1, &despues);
+
+	printf("prueba_traspaso: %d hilos x %d vueltas en %d ticks\n",
+		NUM_HILOS, NUM_VUELTAS, tiempos_proceso(0) - ini);
+	printf("prueba_traspaso: %d cambios voluntarios\n",
+		despues.cambios_voluntarios - antes.cambios_voluntarios);
+	printf("prueba_traspaso: al terminar el hilo %d el mas retrasado llevaba %d vueltas\n",
+		primero_en_terminar, avance_min);
+
+	printf("prueba_traspaso: termina\n");
+	return 0;
+}
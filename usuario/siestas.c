@@ -0,0 +1,26 @@
+/*
+ * usuario/siestas.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que encadena varias siestas cortas. Lo usa
+ * prueba_rueda para mantener muchos plazos pendientes a la vez.
+ */
+
+#include "servicios.h"
+
+#define NUM_SIESTAS 20
+#define DURACION 50	/* en milisegundos */
+
+int main(){
+	int i;
+
+	for (i=0; i<NUM_SIESTAS; i++)
+		dormir_ms(DURACION);
+	return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * usuario/tarea_tr.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Fernando Pérez Costoya
+ *
+ */
+
+/*
+ * Programa de usuario que forma parte de la prueba de tiempo real
+ * (prueba_edf): tarea periódica de periodo 10 ticks que gasta 3 ticks de
+ * su presupuesto de 4 en cada periodo.
+ */
+
+#include "servicios.h"
+
+#define PERIODOS 20
+
+/* gasta el numero de ticks de CPU indicado */
+static void trabajar(int ticks){
+	struct tiempos_ejec t;
+	int fin;
+
+	tiempos_proceso(&t);
+	fin=t.usuario+t.sistema+ticks;
+	do
+		tiempos_proceso(&t);
+	while (t.usuario+t.sistema<fin);
+}
+
+int main(){
+	int i, id;
+	struct info_tiempo_real info;
+
+	id=obtener_id_pr();
+	if (fijar_tiempo_real(10, 4, 10)<0)
+		printf("tarea_tr (%d): no admitida. NO DEBE APARECER\n", id);
+
+	for (i=0; i<PERIODOS; i++){
+		trabajar(3);
+		esperar_periodo();
+	}
+
+	info_tiempo_real(&info);
+	printf("tarea_tr (%d): termina. Plazos incumplidos %d (debe ser 0) excesos %d\n",
+		id, info.plazos_incumplidos, info.excesos_presupuesto);
+	return 0;
+}